@@ -0,0 +1,45 @@
+#include "bench.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include "bosswestfalen/runtime_array_arena.hpp"
+#include <cstddef>
+#include <vector>
+
+
+namespace
+{
+constexpr auto Arrays = std::size_t{1'000'000};
+constexpr auto Elements = std::size_t{8};
+constexpr auto Repetitions = 5;
+
+/// create and destroy a batch of arrays with std::allocator
+void batch_std_allocator()
+{
+    auto batch = std::vector<bosswestfalen::runtime_array<int>>{};
+    batch.reserve(Arrays);
+    for (auto i = std::size_t{0}; i < Arrays; ++i)
+    {
+        batch.emplace_back(Elements, static_cast<int>(i));
+    }
+    bench::do_not_optimize(batch.back().data());
+}
+
+/// create and destroy a batch of arrays from an arena
+void batch_arena()
+{
+    auto arena = bosswestfalen::runtime_array_arena{};
+    auto batch = std::vector<bosswestfalen::arena_runtime_array<int>>{};
+    batch.reserve(Arrays);
+    for (auto i = std::size_t{0}; i < Arrays; ++i)
+    {
+        batch.emplace_back(Elements, static_cast<int>(i), arena);
+    }
+    bench::do_not_optimize(batch.back().data());
+}
+} // namespace
+
+
+int main()
+{
+    bench::report("batch of 1M arrays, std::allocator", bench::best_of(Repetitions, batch_std_allocator));
+    bench::report("batch of 1M arrays, runtime_array_arena", bench::best_of(Repetitions, batch_arena));
+}
@@ -0,0 +1,63 @@
+#include "bench.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include "bosswestfalen/runtime_bitarray.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+
+namespace
+{
+constexpr auto Flags = std::size_t{1} << 28;
+constexpr auto Lookups = std::size_t{1} << 24;
+constexpr auto Repetitions = 5;
+
+using bools = bosswestfalen::runtime_array<bool>;
+using bits = bosswestfalen::runtime_bitarray<>;
+
+/// mark random nodes as visited, count the ones visited before
+template <typename Set>
+void visit(Set& visited, bosswestfalen::runtime_array<std::uint32_t> const& nodes)
+{
+    auto seen = std::size_t{0};
+    for (auto const node : nodes)
+    {
+        seen += visited[node] ? 1 : 0;
+        visited[node] = true;
+    }
+    bench::do_not_optimize(seen);
+}
+} // namespace
+
+
+int main()
+{
+    auto generator = std::mt19937{42};
+    auto distribution = std::uniform_int_distribution<std::uint32_t>{0, Flags - 1};
+    auto const nodes = bosswestfalen::runtime_array<std::uint32_t>(Lookups, bosswestfalen::generate,
+                                                                   [&](std::size_t) { return distribution(generator); });
+
+    auto a_bools = bools(Flags, false);
+    auto b_bools = bools(Flags, true);
+    auto a_bits = bits(Flags);
+    auto b_bits = bits(Flags, true);
+
+    std::printf("256M flags: runtime_array<bool> %zu MiB, runtime_bitarray %zu MiB\n", Flags >> 20, (a_bits.word_count() * 8) >> 20);
+
+    bench::report("fill, runtime_array<bool>", bench::best_of(Repetitions, [&] { a_bools.fill(true); bench::do_not_optimize(a_bools.data()); }));
+    bench::report("fill, runtime_bitarray", bench::best_of(Repetitions, [&] { a_bits.fill(true); bench::do_not_optimize(a_bits.data()); }));
+
+    bench::report("count, runtime_array<bool>",
+                  bench::best_of(Repetitions, [&] { bench::do_not_optimize(std::count(a_bools.cbegin(), a_bools.cend(), true)); }));
+    bench::report("count, runtime_bitarray", bench::best_of(Repetitions, [&] { bench::do_not_optimize(a_bits.count()); }));
+
+    bench::report("xor, runtime_array<bool>", bench::best_of(Repetitions, [&] {
+                      std::transform(a_bools.cbegin(), a_bools.cend(), b_bools.cbegin(), a_bools.begin(), [](bool const x, bool const y) { return x not_eq y; });
+                      bench::do_not_optimize(a_bools.data());
+                  }));
+    bench::report("xor, runtime_bitarray", bench::best_of(Repetitions, [&] { a_bits ^= b_bits; bench::do_not_optimize(a_bits.data()); }));
+
+    bench::report("16M random visits, runtime_array<bool>", bench::best_of(Repetitions, [&] { visit(a_bools, nodes); }));
+    bench::report("16M random visits, runtime_bitarray", bench::best_of(Repetitions, [&] { visit(a_bits, nodes); }));
+}
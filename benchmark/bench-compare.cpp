@@ -0,0 +1,41 @@
+#include "bench.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include <cstdint>
+#include <cstdio>
+
+
+namespace
+{
+constexpr auto Bytes = std::size_t{256} * 1024 * 1024;
+constexpr auto Repetitions = 5;
+
+/// compare two equal arrays of T, the last element of the second one is larger
+template <typename T>
+void compare(char const* const name)
+{
+    auto const lhs = bosswestfalen::runtime_array<T>(Bytes / sizeof(T), T{1});
+    auto rhs = lhs;
+    rhs.back() = T{2};
+
+    std::printf("%s\n", name);
+    bench::report("  operator==", bench::best_of(Repetitions, [&] { bench::do_not_optimize(lhs == rhs); }));
+    bench::report("  operator<", bench::best_of(Repetitions, [&] { bench::do_not_optimize(lhs < rhs); }));
+    bench::report("  mismatch()", bench::best_of(Repetitions, [&] { bench::do_not_optimize(lhs.mismatch(rhs)); }));
+    bench::report("  std::equal", bench::best_of(Repetitions, [&] {
+                      bench::do_not_optimize(std::equal(lhs.begin(), lhs.end(), rhs.begin()));
+                  }));
+    bench::report("  std::lexicographical_compare", bench::best_of(Repetitions, [&] {
+                      bench::do_not_optimize(std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end()));
+                  }));
+}
+} // namespace
+
+
+int main()
+{
+    std::printf("256 MiB arrays differing in the last element\n");
+    compare<unsigned char>("unsigned char");
+    compare<std::int32_t>("int32_t");
+    compare<float>("float");
+    compare<double>("double");
+}
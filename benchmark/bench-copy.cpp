@@ -0,0 +1,38 @@
+#include "bench.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include <cstdio>
+
+
+namespace
+{
+constexpr auto Assignments = 1000000;
+constexpr auto Repetitions = 5;
+
+/// assign equally sized arrays of n doubles back and forth, like double buffering
+void assign(std::size_t const n)
+{
+    using array = bosswestfalen::runtime_array<double>;
+    auto front = array(n, 1.0);
+    auto back = array(n, 2.0);
+
+    auto const ms = bench::best_of(Repetitions, [&] {
+        for (auto i = 0; i < Assignments; ++i)
+        {
+            back = front;
+            bench::do_not_optimize(back.data());
+        }
+    });
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "1M assignments of %zu doubles", n);
+    bench::report(name, ms);
+}
+} // namespace
+
+
+int main()
+{
+    assign(16);
+    assign(256);
+    assign(4096);
+}
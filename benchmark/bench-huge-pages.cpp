@@ -0,0 +1,55 @@
+#include "bench.hpp"
+#include "bosswestfalen/huge_page_allocator.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include <cstdint>
+#include <cstdlib>
+
+
+namespace
+{
+constexpr auto Lookups = std::size_t{20'000'000};
+constexpr auto Repetitions = 3;
+
+/// random reads into rta, each index depends on the previous value
+template <typename A>
+void random_access(A const& rta)
+{
+    auto index = std::uint64_t{0};
+    auto sum = std::uint64_t{0};
+    auto const mask = rta.size() - 1;
+    for (auto i = std::size_t{0}; i < Lookups; ++i)
+    {
+        auto const value = rta[index & mask];
+        sum += value;
+        index = index * 6364136223846793005ULL + 1442695040888963407ULL + value;
+    }
+    bench::do_not_optimize(sum);
+}
+
+/// create array of n elements and measure the lookups
+template <typename A>
+void run(char const* const name, std::size_t const n)
+{
+    auto rta = A(n);
+    for (auto i = std::size_t{0}; i < n; ++i)
+    {
+        rta[i] = i;
+    }
+    bench::report(name, bench::best_of(Repetitions, [&rta] { random_access(rta); }));
+}
+} // namespace
+
+
+/// optional argument: size of the table in MiB, rounded down to a power of two
+int main(int argc, char** argv)
+{
+    auto const mib = std::size_t{(argc > 1) ? std::strtoul(argv[1], nullptr, 10) : 1024};
+    auto n = std::size_t{1};
+    while (n * 2 * sizeof(std::uint64_t) <= mib * 1024 * 1024)
+    {
+        n *= 2;
+    }
+
+    run<bosswestfalen::runtime_array<std::uint64_t>>("20M random reads, std::allocator", n);
+    run<bosswestfalen::huge_page_runtime_array<std::uint64_t>>("20M random reads, huge_page_allocator", n);
+}
@@ -0,0 +1,81 @@
+#include "bench.hpp"
+#include "bosswestfalen/runtime_mdarray.hpp"
+#include <cstdio>
+
+
+namespace
+{
+constexpr auto Rows = std::size_t{4096};
+constexpr auto Cols = std::size_t{4096};
+constexpr auto Repetitions = 5;
+
+/// sum each column, indices computed by hand on a flat runtime_array
+void column_sums_flat(bosswestfalen::runtime_array<float> const& flat, std::size_t const rows, std::size_t const cols,
+                      bosswestfalen::runtime_array<float>& sums)
+{
+    for (auto j = std::size_t{0}; j < cols; ++j)
+    {
+        auto sum = 0.0f;
+        for (auto i = std::size_t{0}; i < rows; ++i)
+        {
+            sum += flat[i * cols + j];
+        }
+        sums[j] = sum;
+    }
+    bench::do_not_optimize(sums.data());
+}
+
+/// sum each column of a matrix
+template <typename Layout>
+void column_sums(bosswestfalen::runtime_array2d<float, Layout> const& matrix, bosswestfalen::runtime_array<float>& sums)
+{
+    auto const view = matrix.view();
+    for (auto j = std::size_t{0}; j < view.extent(1); ++j)
+    {
+        auto sum = 0.0f;
+        for (auto i = std::size_t{0}; i < view.extent(0); ++i)
+        {
+            sum += view(i, j);
+        }
+        sums[j] = sum;
+    }
+    bench::do_not_optimize(sums.data());
+}
+
+/// sum each row of a matrix
+template <typename Layout>
+void row_sums(bosswestfalen::runtime_array2d<float, Layout> const& matrix, bosswestfalen::runtime_array<float>& sums)
+{
+    auto const view = matrix.view();
+    for (auto i = std::size_t{0}; i < view.extent(0); ++i)
+    {
+        auto sum = 0.0f;
+        for (auto j = std::size_t{0}; j < view.extent(1); ++j)
+        {
+            sum += view(i, j);
+        }
+        sums[i] = sum;
+    }
+    bench::do_not_optimize(sums.data());
+}
+} // namespace
+
+
+int main(int argc, char**)
+{
+    // extents only known at runtime, as with images read from files
+    auto const rows = Rows + static_cast<std::size_t>(argc - 1);
+    auto const cols = Cols + static_cast<std::size_t>(argc - 1);
+
+    auto const flat = bosswestfalen::runtime_array<float>(rows * cols, 1.0f);
+    auto const row_major = bosswestfalen::runtime_array2d<float>(bosswestfalen::dextents<2>{rows, cols}, 1.0f);
+    auto const col_major = bosswestfalen::runtime_array2d<float, bosswestfalen::layout_left>(bosswestfalen::dextents<2>{rows, cols}, 1.0f);
+    auto sums = bosswestfalen::runtime_array<float>(rows, bosswestfalen::value_initialise);
+
+    std::printf("4096 x 4096 floats\n");
+    bench::report("column sums, flat array, i * cols + j", bench::best_of(Repetitions, [&] { column_sums_flat(flat, rows, cols, sums); }));
+    bench::report("column sums, layout_right", bench::best_of(Repetitions, [&] { column_sums(row_major, sums); }));
+    bench::report("column sums, layout_left", bench::best_of(Repetitions, [&] { column_sums(col_major, sums); }));
+    bench::report("row sums, layout_right", bench::best_of(Repetitions, [&] { row_sums(row_major, sums); }));
+    bench::report("row sums, layout_left", bench::best_of(Repetitions, [&] { row_sums(col_major, sums); }));
+}
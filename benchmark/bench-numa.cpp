@@ -0,0 +1,146 @@
+#include "bench.hpp"
+#include "bosswestfalen/numa_allocator.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if __has_include(<pthread.h>) and __has_include(<sched.h>)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+namespace
+{
+constexpr auto Elements = std::size_t{64} * 1024 * 1024;
+constexpr auto Repetitions = 5;
+
+using array = bosswestfalen::numa_runtime_array<std::uint64_t>;
+
+/// pin the calling thread to the cpus of node, ignored where not supported
+void pin_to_node(unsigned const node)
+{
+#if defined(CPU_SET) and defined(__linux__)
+    auto file = std::ifstream{"/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"};
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    auto first = 0u;
+    auto any = false;
+    while (file >> first)
+    {
+        auto last = first;
+        if (file.peek() == '-')
+        {
+            file.get();
+            file >> last;
+        }
+        for (auto cpu = first; cpu <= last and cpu < CPU_SETSIZE; ++cpu)
+        {
+            CPU_SET(cpu, &cpus);
+            any = true;
+        }
+        if (file.peek() == ',')
+        {
+            file.get();
+        }
+    }
+    if (any)
+    {
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+#else
+    static_cast<void>(node);
+#endif
+}
+
+/// sum all elements with threads spread over the given nodes, return GB/s
+auto read_bandwidth(array const& rta, std::vector<unsigned> const& nodes, unsigned const threads) -> double
+{
+    auto const ms = bench::best_of(Repetitions, [&] {
+        auto workers = std::vector<std::thread>{};
+        for (auto t = 0u; t < threads; ++t)
+        {
+            workers.emplace_back([&, t] {
+                pin_to_node(nodes[t % nodes.size()]);
+                auto const begin = rta.size() * t / threads;
+                auto const end = rta.size() * (t + 1) / threads;
+                auto sum = std::uint64_t{0};
+                for (auto i = begin; i < end; ++i)
+                {
+                    sum += rta[i];
+                }
+                bench::do_not_optimize(sum);
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    });
+    return static_cast<double>(rta.size() * sizeof(std::uint64_t)) / ms / 1e6;
+}
+
+/// print one bandwidth line
+void report_bandwidth(std::string const& name, double const gigabytes_per_second)
+{
+    std::printf("%-50s %12.3f GB/s\n", name.c_str(), gigabytes_per_second);
+}
+} // namespace
+
+
+int main()
+{
+    using bosswestfalen::numa_policy;
+
+    auto nodes = std::vector<unsigned>{};
+    for (auto node = 0u; node < 64; ++node)
+    {
+        if (bosswestfalen::numa_online_nodes() & (std::uint64_t{1} << node))
+        {
+            nodes.push_back(node);
+        }
+    }
+    auto const threads = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("512 MiB arrays, %zu nodes, %u threads\n", nodes.size(), threads);
+
+    // every worker initialises the part it reads later
+    {
+        auto rta = array(Elements, bosswestfalen::for_overwrite);
+        auto workers = std::vector<std::thread>{};
+        for (auto t = 0u; t < threads; ++t)
+        {
+            workers.emplace_back([&, t] {
+                pin_to_node(nodes[t % nodes.size()]);
+                for (auto i = Elements * t / threads; i < Elements * (t + 1) / threads; ++i)
+                {
+                    rta[i] = i;
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        report_bandwidth("first touch, all nodes", read_bandwidth(rta, nodes, threads));
+    }
+
+    {
+        auto const rta = array(Elements, 1, numa_policy::interleave());
+        report_bandwidth("interleave, all nodes", read_bandwidth(rta, nodes, threads));
+    }
+
+    // per socket: memory bound to one node, read from each node
+    for (auto const memory : nodes)
+    {
+        auto const rta = array(Elements, 1, numa_policy::bind(memory));
+        for (auto const reader : nodes)
+        {
+            auto const name = "bind node " + std::to_string(memory) + ", read from node " + std::to_string(reader);
+            report_bandwidth(name, read_bandwidth(rta, {reader}, std::max(1u, threads / static_cast<unsigned>(nodes.size()))));
+        }
+    }
+}
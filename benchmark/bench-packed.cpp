@@ -0,0 +1,66 @@
+#include "bench.hpp"
+#include "bosswestfalen/packed_runtime_array.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+
+namespace
+{
+constexpr auto Ids = std::size_t{1} << 26;
+constexpr auto Lookups = std::size_t{1} << 24;
+constexpr auto Repetitions = 5;
+
+using slots = bosswestfalen::runtime_array<std::uint64_t>;
+using packed = bosswestfalen::packed_runtime_array<20>;
+
+/// remap random ids
+template <typename Table>
+void remap(Table const& table, bosswestfalen::runtime_array<std::uint32_t> const& ids)
+{
+    auto sum = std::uint64_t{0};
+    for (auto const id : ids)
+    {
+        sum += table[id];
+    }
+    bench::do_not_optimize(sum);
+}
+} // namespace
+
+
+int main()
+{
+    auto generator = std::mt19937{42};
+    auto values = std::uniform_int_distribution<std::uint64_t>{0, packed::max_value};
+    auto const table = slots(Ids, bosswestfalen::generate, [&](std::size_t) { return values(generator); });
+    auto positions = std::uniform_int_distribution<std::uint32_t>{0, Ids - 1};
+    auto const ids = bosswestfalen::runtime_array<std::uint32_t>(Lookups, bosswestfalen::generate,
+                                                                 [&](std::size_t) { return positions(generator); });
+
+    auto const packed_table = packed(table);
+    std::printf("64M 20 bit ids: runtime_array<uint64_t> %zu MiB, packed_runtime_array<20> %zu MiB\n",
+                (table.size() * 8) >> 20, (packed_table.word_count() * 8) >> 20);
+
+    bench::report("16M random lookups, runtime_array<uint64_t>", bench::best_of(Repetitions, [&] { remap(table, ids); }));
+    bench::report("16M random lookups, packed_runtime_array<20>", bench::best_of(Repetitions, [&] { remap(packed_table, ids); }));
+
+    auto out32 = bosswestfalen::runtime_array<std::uint32_t>(Ids, bosswestfalen::for_overwrite);
+    auto out64 = slots(Ids, bosswestfalen::for_overwrite);
+    bench::report("unpack into uint32_t", bench::best_of(Repetitions, [&] {
+                      packed_table.unpack(0, Ids, out32.data());
+                      bench::do_not_optimize(out32.data());
+                  }));
+    bench::report("unpack into uint64_t", bench::best_of(Repetitions, [&] {
+                      packed_table.unpack(0, Ids, out64.data());
+                      bench::do_not_optimize(out64.data());
+                  }));
+    bench::report("unpack one by one into uint64_t", bench::best_of(Repetitions, [&] {
+                      for (auto i = std::size_t{0}; i < Ids; ++i)
+                      {
+                          out64[i] = packed_table.get(i);
+                      }
+                      bench::do_not_optimize(out64.data());
+                  }));
+    bench::report("pack from uint64_t", bench::best_of(Repetitions, [&] { bench::do_not_optimize(packed(table).data()); }));
+}
@@ -0,0 +1,29 @@
+#include "bench.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+
+
+namespace
+{
+constexpr auto Elements = std::size_t{128} * 1024 * 1024;
+constexpr auto Repetitions = 3;
+} // namespace
+
+
+int main()
+{
+    using array = bosswestfalen::runtime_array<std::uint32_t>;
+    std::printf("512 MiB arrays, %u hardware threads\n", std::thread::hardware_concurrency());
+
+    bench::report("create with value, sequential", bench::best_of(Repetitions, [] { bench::do_not_optimize(array(Elements, 1).data()); }));
+    bench::report("create with value, parallel", bench::best_of(Repetitions, [] { bench::do_not_optimize(array(bosswestfalen::parallel, Elements, 1).data()); }));
+
+    auto src = array(Elements, 1);
+    bench::report("copy, sequential", bench::best_of(Repetitions, [&src] { bench::do_not_optimize(array(src).data()); }));
+    bench::report("copy, parallel", bench::best_of(Repetitions, [&src] { bench::do_not_optimize(array(bosswestfalen::parallel, src).data()); }));
+
+    bench::report("fill, sequential", bench::best_of(Repetitions, [&src] { src.fill(2); }));
+    bench::report("fill, parallel", bench::best_of(Repetitions, [&src] { src.fill(bosswestfalen::parallel, 3); }));
+}
@@ -0,0 +1,34 @@
+#include "bench.hpp"
+#include "bosswestfalen/page_allocator.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include <cstdint>
+#include <cstdio>
+
+
+namespace
+{
+constexpr auto Elements = std::size_t{64} * 1024 * 1024;
+constexpr auto Repetitions = 3;
+
+/// grow an array of 512 MiB to 1 GiB and measure reallocate() only
+template <typename Array>
+auto grow() -> double
+{
+    auto best = 1e300;
+    for (auto r = 0; r < Repetitions; ++r)
+    {
+        auto rta = Array(Elements, 1);
+        best = std::min(best, bench::best_of(1, [&rta] { rta.reallocate(2 * Elements); }));
+        bench::do_not_optimize(rta.data());
+    }
+    return best;
+}
+} // namespace
+
+
+int main()
+{
+    std::printf("grow 512 MiB of uint64_t to 1 GiB\n");
+    bench::report("std::allocator (allocate, memcpy, free)", grow<bosswestfalen::runtime_array<std::uint64_t>>());
+    bench::report("page_allocator (mremap)", grow<bosswestfalen::page_runtime_array<std::uint64_t>>());
+}
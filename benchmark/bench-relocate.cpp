@@ -0,0 +1,81 @@
+#include "bench.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+
+namespace
+{
+constexpr auto Arrays = 1000000;
+constexpr auto Elements = std::size_t{16};
+constexpr auto Repetitions = 5;
+
+using array = bosswestfalen::runtime_array<int>;
+
+/// runtime_array whose move ctor may throw, as before moves were noexcept
+struct throwing_move_array
+{
+    explicit throwing_move_array(array a)
+        : value{std::move(a)}
+    {
+    }
+
+    throwing_move_array(throwing_move_array const&) = default;
+
+    throwing_move_array(throwing_move_array&& orig) noexcept(false)
+        : value{std::move(orig.value)}
+    {
+    }
+
+    array value;
+};
+
+/// push_back into a std::vector without reserve
+template <typename E>
+void grow_vector()
+{
+    auto arrays = std::vector<E>{};
+    for (auto i = 0; i < Arrays; ++i)
+    {
+        arrays.emplace_back(array(Elements, i));
+    }
+    bench::do_not_optimize(arrays.data());
+}
+
+/// grow a buffer geometrically, relocating its runtime_arrays with memcpy
+void grow_relocating()
+{
+    auto storage = std::allocator<array>{};
+    auto capacity = std::size_t{1};
+    auto size = std::size_t{0};
+    auto data = storage.allocate(capacity);
+
+    for (auto i = 0; i < Arrays; ++i)
+    {
+        if (size == capacity)
+        {
+            auto const grown = storage.allocate(2 * capacity);
+            bosswestfalen::uninitialized_relocate_n(data, size, grown);
+            storage.deallocate(data, capacity);
+            data = grown;
+            capacity *= 2;
+        }
+        ::new (static_cast<void*>(data + size)) array(Elements, i);
+        ++size;
+    }
+    bench::do_not_optimize(data);
+
+    std::destroy_n(data, size);
+    storage.deallocate(data, capacity);
+}
+} // namespace
+
+
+int main()
+{
+    std::printf("1M runtime_arrays of 16 ints, appended without reserve\n");
+    bench::report("std::vector, move may throw (copies)", bench::best_of(Repetitions, grow_vector<throwing_move_array>));
+    bench::report("std::vector, noexcept move", bench::best_of(Repetitions, grow_vector<array>));
+    bench::report("uninitialized_relocate_n", bench::best_of(Repetitions, grow_relocating));
+}
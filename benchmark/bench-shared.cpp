@@ -0,0 +1,80 @@
+#include "bench.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include "bosswestfalen/shared_runtime_array.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+constexpr auto Elements = std::size_t{1} << 23;
+constexpr auto SmallElements = std::size_t{16};
+constexpr auto SmallArrays = 1000000;
+constexpr auto Repetitions = 5;
+
+using array = bosswestfalen::runtime_array<double>;
+using shared = bosswestfalen::shared_runtime_array<double>;
+
+/// sum the elements
+template <typename Range>
+auto sum(Range const& range) -> double
+{
+    return std::accumulate(range.begin(), range.end(), 0.0);
+}
+
+/// hand a copy of table to each of n threads, each thread sums its copy
+template <typename Table, typename Unwrap>
+void fan_out(Table const& table, unsigned const n, Unwrap unwrap)
+{
+    auto workers = std::vector<std::thread>{};
+    workers.reserve(n);
+    for (auto t = 0u; t < n; ++t)
+    {
+        workers.emplace_back([table, unwrap] { bench::do_not_optimize(sum(unwrap(table))); });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    auto const threads = (argc > 1) ? static_cast<unsigned>(std::atoi(argv[1])) : std::max(1u, std::thread::hardware_concurrency());
+    auto const same = [](auto const& table) -> auto const& { return table; };
+    auto const deref = [](auto const& table) -> auto const& { return *table; };
+
+    auto const table = array(Elements, bosswestfalen::generate, [](std::size_t const i) { return static_cast<double>(i); });
+    auto const pointer = std::make_shared<array const>(table);
+    auto const frozen = shared(table);
+
+    std::printf("fan-out of 64 MiB to %u threads\n", threads);
+    bench::report("deep copy of runtime_array", bench::best_of(Repetitions, [&] { fan_out(table, threads, same); }));
+    bench::report("shared_ptr<runtime_array const>", bench::best_of(Repetitions, [&] { fan_out(pointer, threads, deref); }));
+    bench::report("shared_runtime_array", bench::best_of(Repetitions, [&] { fan_out(frozen, threads, same); }));
+
+    bench::report("1M small shared_ptr<runtime_array const>", bench::best_of(Repetitions, [&] {
+                      auto arrays = std::vector<std::shared_ptr<array const>>{};
+                      arrays.reserve(SmallArrays);
+                      for (auto i = 0; i < SmallArrays; ++i)
+                      {
+                          arrays.push_back(std::make_shared<array const>(SmallElements, 1.0));
+                      }
+                      bench::do_not_optimize(arrays.data());
+                  }));
+    bench::report("1M small shared_runtime_array", bench::best_of(Repetitions, [&] {
+                      auto arrays = std::vector<shared>{};
+                      arrays.reserve(SmallArrays);
+                      for (auto i = 0; i < SmallArrays; ++i)
+                      {
+                          arrays.emplace_back(SmallElements, 1.0);
+                      }
+                      bench::do_not_optimize(arrays.data());
+                  }));
+}
@@ -0,0 +1,84 @@
+#include "bench.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include "bosswestfalen/runtime_soa.hpp"
+#include <cstdio>
+#include <numeric>
+
+
+namespace
+{
+constexpr auto Rows = std::size_t{1} << 22;
+constexpr auto Repetitions = 10;
+
+/// a particle with 8 fields of 8 bytes, i.e. one cache line per row
+struct particle
+{
+    double x;
+    double y;
+    double z;
+    double vx;
+    double vy;
+    double vz;
+    double mass;
+    double charge;
+};
+
+using array_of_structs = bosswestfalen::runtime_array<particle>;
+using struct_of_arrays = bosswestfalen::runtime_soa<double, double, double, double, double, double, double, double>;
+
+/// sum one field of all rows
+void sum_one(array_of_structs const& aos)
+{
+    auto sum = 0.0;
+    for (auto const& p : aos)
+    {
+        sum += p.mass;
+    }
+    bench::do_not_optimize(&sum);
+}
+
+/// \copydoc sum_one
+void sum_one(struct_of_arrays const& soa)
+{
+    auto const mass = soa.column<6>();
+    auto sum = std::accumulate(mass.begin(), mass.end(), 0.0);
+    bench::do_not_optimize(&sum);
+}
+
+/// sum the product of two fields of all rows
+void sum_two(array_of_structs const& aos)
+{
+    auto sum = 0.0;
+    for (auto const& p : aos)
+    {
+        sum += p.mass * p.vx;
+    }
+    bench::do_not_optimize(&sum);
+}
+
+/// \copydoc sum_two
+void sum_two(struct_of_arrays const& soa)
+{
+    auto const mass = soa.data<6>();
+    auto const vx = soa.data<3>();
+    auto sum = 0.0;
+    for (auto i = std::size_t{0}; i < soa.size(); ++i)
+    {
+        sum += mass[i] * vx[i];
+    }
+    bench::do_not_optimize(&sum);
+}
+} // namespace
+
+
+int main()
+{
+    auto const aos = array_of_structs(Rows, particle{1.0, 2.0, 3.0, 0.5, 0.25, 0.125, 2.0, -1.0});
+    auto const soa = struct_of_arrays(Rows, {1.0, 2.0, 3.0, 0.5, 0.25, 0.125, 2.0, -1.0});
+
+    std::printf("4M rows of 8 doubles\n");
+    bench::report("sum 1 field, runtime_array<struct>", bench::best_of(Repetitions, [&aos] { sum_one(aos); }));
+    bench::report("sum 1 field, runtime_soa", bench::best_of(Repetitions, [&soa] { sum_one(soa); }));
+    bench::report("sum 2 fields, runtime_array<struct>", bench::best_of(Repetitions, [&aos] { sum_two(aos); }));
+    bench::report("sum 2 fields, runtime_soa", bench::best_of(Repetitions, [&soa] { sum_two(soa); }));
+}
@@ -0,0 +1,145 @@
+#include "bench.hpp"
+#include "bosswestfalen/runtime_mdarray.hpp"
+#include "bosswestfalen/tiled_layouts.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+
+namespace
+{
+constexpr auto Extent = std::size_t{4096};
+constexpr auto Repetitions = 5;
+
+using tiled = bosswestfalen::layout_tiled<64, 64>;
+
+template <typename Layout>
+using matrix = bosswestfalen::runtime_array2d<float, Layout>;
+
+/// dst(j, i) = src(i, j), row by row
+template <typename Layout>
+void transpose(matrix<Layout> const& src, matrix<Layout>& dst)
+{
+    auto const s = src.view();
+    auto const d = dst.view();
+    for (auto i = std::size_t{0}; i < s.extent(0); ++i)
+    {
+        for (auto j = std::size_t{0}; j < s.extent(1); ++j)
+        {
+            d(j, i) = s(i, j);
+        }
+    }
+    bench::do_not_optimize(d.data());
+}
+
+/// dst(j, i) = src(i, j), tile (r, c) of src goes to tile (c, r) of dst
+void transpose_tiles(matrix<tiled> const& src, matrix<tiled>& dst)
+{
+    auto const dst_tiles = bosswestfalen::tiles(dst.view());
+    for (auto const& [row, col, s] : bosswestfalen::tiles(src.view()))
+    {
+        auto const d = dst_tiles(col / tiled::tile_cols, row / tiled::tile_rows).view;
+        for (auto i = std::size_t{0}; i < s.extent(0); ++i)
+        {
+            for (auto j = std::size_t{0}; j < s.extent(1); ++j)
+            {
+                d(j, i) = s(i, j);
+            }
+        }
+    }
+    bench::do_not_optimize(dst.data());
+}
+
+/// 5-point stencil of the inner elements of one block
+template <typename In, typename Out>
+void stencil_block(In const& in, Out const& out, std::size_t const first_row, std::size_t const last_row,
+                   std::size_t const first_col, std::size_t const last_col)
+{
+    for (auto i = first_row; i < last_row; ++i)
+    {
+        for (auto j = first_col; j < last_col; ++j)
+        {
+            out(i, j) = 0.2f * (in(i, j) + in(i - 1, j) + in(i + 1, j) + in(i, j - 1) + in(i, j + 1));
+        }
+    }
+}
+
+/// 5-point stencil, row by row
+template <typename Layout>
+void stencil(matrix<Layout> const& in, matrix<Layout>& out)
+{
+    auto const n = in.extent(0);
+    stencil_block(in.view(), out.view(), 1, n - 1, 1, n - 1);
+    bench::do_not_optimize(out.data());
+}
+
+/// 5-point stencil, tile by tile
+void stencil_tiles(matrix<tiled> const& in, matrix<tiled>& out)
+{
+    using full_tile = bosswestfalen::mdspan<float, bosswestfalen::extents<tiled::tile_rows, tiled::tile_cols>>;
+    using const_full_tile = bosswestfalen::mdspan<float const, bosswestfalen::extents<tiled::tile_rows, tiled::tile_cols>>;
+
+    auto const n = in.extent(0);
+    auto const in_view = in.view();
+    auto const out_view = out.view();
+    for (auto const& [row, col, block] : bosswestfalen::tiles(out_view))
+    {
+        auto const first_row = std::max(row, std::size_t{1});
+        auto const last_row = std::min(row + block.extent(0), n - 1);
+        auto const first_col = std::max(col, std::size_t{1});
+        auto const last_col = std::min(col + block.extent(1), n - 1);
+
+        if (block.extent(0) not_eq tiled::tile_rows or block.extent(1) not_eq tiled::tile_cols)
+        {
+            stencil_block(in_view, out_view, first_row, last_row, first_col, last_col);
+            continue;
+        }
+
+        // inside a full tile all neighbours are in the same tile, addressed with compile time extents
+        auto const offset = in.mapping().tile_offset(row / tiled::tile_rows, col / tiled::tile_cols);
+        stencil_block(const_full_tile{in.data() + offset}, full_tile{out.data() + offset}, 1, tiled::tile_rows - 1, 1,
+                      tiled::tile_cols - 1);
+
+        // the border of the tile needs neighbouring tiles
+        stencil_block(in_view, out_view, first_row, row + 1, first_col, last_col);
+        stencil_block(in_view, out_view, std::max(first_row, last_row - 1), last_row, first_col, last_col);
+        stencil_block(in_view, out_view, first_row, last_row, first_col, col + 1);
+        stencil_block(in_view, out_view, first_row, last_row, std::max(first_col, last_col - 1), last_col);
+    }
+    bench::do_not_optimize(out.data());
+}
+
+/// fill and run the benchmarks of one layout
+template <typename Layout, typename Transpose, typename Stencil>
+void run(char const* const name, std::size_t const n, Transpose transpose_kernel, Stencil stencil_kernel)
+{
+    auto src = matrix<Layout>(bosswestfalen::dextents<2>{n, n}, 1.0f);
+    auto dst = matrix<Layout>(bosswestfalen::dextents<2>{n, n}, 0.0f);
+
+    std::printf("%s\n", name);
+    bench::report("  transpose", bench::best_of(Repetitions, [&] { transpose_kernel(src, dst); }));
+    bench::report("  5-point stencil", bench::best_of(Repetitions, [&] { stencil_kernel(src, dst); }));
+}
+} // namespace
+
+
+int main(int argc, char**)
+{
+    // extents only known at runtime
+    auto const n = Extent + static_cast<std::size_t>(argc - 1);
+
+    std::printf("4096 x 4096 floats\n");
+    run<bosswestfalen::layout_right>("layout_right", n, transpose<bosswestfalen::layout_right>, stencil<bosswestfalen::layout_right>);
+    run<tiled>("layout_tiled<64, 64>, naive loops", n, transpose<tiled>, stencil<tiled>);
+    run<tiled>("layout_tiled<64, 64>, tile by tile", n, transpose_tiles, stencil_tiles);
+    run<bosswestfalen::layout_morton>("layout_morton", n, transpose<bosswestfalen::layout_morton>, stencil<bosswestfalen::layout_morton>);
+
+    auto const row_major = matrix<bosswestfalen::layout_right>(bosswestfalen::dextents<2>{n, n}, 1.0f);
+    auto tiled_copy = matrix<tiled>(bosswestfalen::dextents<2>{n, n});
+    auto row_major_copy = matrix<bosswestfalen::layout_right>(bosswestfalen::dextents<2>{n, n});
+    std::printf("conversion\n");
+    bench::report("  layout_right to layout_tiled<64, 64>",
+                  bench::best_of(Repetitions, [&] { bosswestfalen::copy_elements(row_major.view(), tiled_copy.view()); }));
+    bench::report("  layout_tiled<64, 64> to layout_right",
+                  bench::best_of(Repetitions, [&] { bosswestfalen::copy_elements(std::as_const(tiled_copy).view(), row_major_copy.view()); }));
+}
@@ -0,0 +1,55 @@
+#include "bench.hpp"
+#include "bosswestfalen/page_allocator.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+
+namespace
+{
+constexpr auto Bins = std::size_t{64} * 1024 * 1024;
+constexpr auto Touches = std::size_t{10'000};
+constexpr auto Repetitions = 3;
+
+/// resident set size of the process in MiB
+auto resident_mib() -> double
+{
+    auto statm = std::ifstream{"/proc/self/statm"};
+    auto pages = std::size_t{0};
+    auto resident = std::size_t{0};
+    statm >> pages >> resident;
+    return static_cast<double>(resident * bosswestfalen::detail::page_size()) / (1024.0 * 1024.0);
+}
+
+/// create a zeroed histogram and increment a few bins spread over the whole array
+template <typename A>
+void run(std::string const& name)
+{
+    auto const construction = bench::best_of(Repetitions, []
+                                             {
+                                                 auto const histogram = A(Bins, bosswestfalen::value_initialise);
+                                                 bench::do_not_optimize(histogram.data());
+                                             });
+
+    auto const rss_before = resident_mib();
+    auto histogram = A(Bins, bosswestfalen::value_initialise);
+    for (auto i = std::size_t{0}; i < Touches; ++i)
+    {
+        ++histogram[(i * 2654435761u) % Bins];
+    }
+    bench::do_not_optimize(histogram.data());
+    auto const rss_after = resident_mib();
+
+    bench::report("construct 256 MiB zeroed histogram, " + name, construction);
+    std::printf("%-50s %12.1f MiB\n", ("  RSS growth after 10k sparse increments, " + name).c_str(), rss_after - rss_before);
+}
+} // namespace
+
+
+int main()
+{
+    run<bosswestfalen::runtime_array<std::uint32_t>>("std::allocator");
+    run<bosswestfalen::page_runtime_array<std::uint32_t>>("page_allocator");
+}
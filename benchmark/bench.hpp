@@ -0,0 +1,56 @@
+/*!
+ * \file bench.hpp
+ * \brief minimal helpers for the benchmarks
+ */
+
+
+#ifndef BOSSWESTFALEN_BENCH_HPP_
+#define BOSSWESTFALEN_BENCH_HPP_
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <string_view>
+
+
+/// helpers for the benchmarks
+namespace bench
+{
+/// keep the compiler from optimising value away
+template <typename T>
+void do_not_optimize(T const& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/*!
+ * \brief run f several times and measure
+ *
+ * \param repetitions number of runs
+ * \param f function to measure
+ * \return fastest run in milliseconds
+ */
+template <typename F>
+auto best_of(int const repetitions, F&& f) -> double
+{
+    auto best = std::numeric_limits<double>::max();
+    for (auto i = 0; i < repetitions; ++i)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        f();
+        auto const stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::milli>(stop - start).count());
+    }
+    return best;
+}
+
+/// print one result line
+inline void report(std::string_view const name, double const milliseconds)
+{
+    std::printf("%-50.*s %12.3f ms\n", static_cast<int>(name.size()), name.data(), milliseconds);
+}
+} // namespace bench
+
+#endif
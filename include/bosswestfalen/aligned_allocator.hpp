@@ -0,0 +1,110 @@
+/*!
+ * \file aligned_allocator.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_ALIGNED_ALLOCATOR_HPP_
+#define BOSSWESTFALEN_ALIGNED_ALLOCATOR_HPP_
+
+
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+
+namespace bosswestfalen
+{
+/// size of a cache line on common hardware
+inline constexpr std::size_t cache_line_size = 64;
+
+/*!
+ * \brief Stateless allocator returning memory with at least Alignment alignment.
+ *
+ * runtime_array picks up the alignment, so runtime_array::alignment and the
+ * alignment of data() reflect it.
+ *
+ * \tparam T type of allocated elements
+ * \tparam Alignment requested alignment, must be a power of two
+ */
+template <typename T, std::size_t Alignment>
+class aligned_allocator final
+{
+    static_assert(Alignment > 0 and (Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two");
+
+  public:
+    /// alias for T
+    using value_type = T;
+
+    /// all instances use the global operator new
+    using is_always_equal = std::true_type;
+
+    /// guaranteed alignment
+    static constexpr std::size_t alignment = (Alignment < alignof(T)) ? alignof(T) : Alignment;
+
+    /// rebind to another element type, keeping the alignment
+    template <typename U>
+    struct rebind
+    {
+        /// rebound allocator
+        using other = aligned_allocator<U, Alignment>;
+    };
+
+    /// default ctor
+    aligned_allocator() noexcept = default;
+
+    /// rebind
+    template <typename U>
+    aligned_allocator(aligned_allocator<U, Alignment> const&) noexcept
+    {
+    }
+
+    /// get aligned memory for n elements
+    [[nodiscard]] auto allocate(std::size_t const n) -> T*
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length{};
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+    }
+
+    /// give back memory of n elements
+    void deallocate(T* const p, std::size_t) noexcept
+    {
+        ::operator delete(p, std::align_val_t{alignment});
+    }
+};
+
+/// all aligned_allocators are equal
+template <typename T, typename U, std::size_t A>
+constexpr bool operator==(aligned_allocator<T, A> const&, aligned_allocator<U, A> const&) noexcept
+{
+    return true;
+}
+
+/// all aligned_allocators are equal
+template <typename T, typename U, std::size_t A>
+constexpr bool operator!=(aligned_allocator<T, A> const&, aligned_allocator<U, A> const&) noexcept
+{
+    return false;
+}
+
+
+/*!
+ * \brief runtime_array whose data() is aligned to Alignment
+ *
+ * Defaults to the size of a cache line, which also suits 512 bit vectors.
+ */
+template <typename T, std::size_t Alignment = cache_line_size>
+using aligned_runtime_array = runtime_array<T, aligned_allocator<T, Alignment>>;
+
+} // namespace bosswestfalen
+
+#endif
@@ -0,0 +1,279 @@
+/*!
+ * \file huge_page_allocator.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_HUGE_PAGE_ALLOCATOR_HPP_
+#define BOSSWESTFALEN_HUGE_PAGE_ALLOCATOR_HPP_
+
+
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#define BOSSWESTFALEN_HAS_MMAP 1
+#else
+#define BOSSWESTFALEN_HAS_MMAP 0
+#endif
+
+
+namespace bosswestfalen
+{
+/// size of a huge page on x86-64 and most AArch64 systems
+inline constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+namespace detail
+{
+/// round bytes up to a multiple of huge_page_size
+constexpr auto round_to_huge_pages(std::size_t const bytes) noexcept -> std::size_t
+{
+    return (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+}
+
+/*!
+ * \brief map anonymous memory backed by huge pages if possible
+ *
+ * Explicit huge pages (MAP_HUGETLB) are tried first. If none are available,
+ * normal memory aligned to huge_page_size is mapped and marked for transparent
+ * huge pages. Without mmap, the global aligned operator new is used.
+ *
+ * \param bytes size, must be a multiple of huge_page_size
+ * \return memory aligned to huge_page_size, filled with zeros if it is mapped
+ * \throw std::bad_alloc if no memory is available
+ */
+inline auto map_huge_pages(std::size_t const bytes) -> void*
+{
+#if BOSSWESTFALEN_HAS_MMAP
+    constexpr auto protection = PROT_READ | PROT_WRITE;
+    constexpr auto flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+#if defined(MAP_HUGETLB)
+    if (auto const p = ::mmap(nullptr, bytes, protection, flags | MAP_HUGETLB, -1, 0); p not_eq MAP_FAILED)
+    {
+        return p;
+    }
+#endif
+
+    // map more than needed and cut off the unaligned parts at both ends
+    auto const mapped = ::mmap(nullptr, bytes + huge_page_size, protection, flags, -1, 0);
+    if (mapped == MAP_FAILED)
+    {
+        throw std::bad_alloc{};
+    }
+
+    auto const begin = reinterpret_cast<std::uintptr_t>(mapped);
+    auto const aligned = (begin + huge_page_size - 1) / huge_page_size * huge_page_size;
+    if (auto const head = aligned - begin; head not_eq 0)
+    {
+        ::munmap(mapped, head);
+    }
+    if (auto const tail = huge_page_size - (aligned - begin); tail not_eq 0)
+    {
+        ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+    }
+
+    auto const p = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+    ::madvise(p, bytes, MADV_HUGEPAGE);
+#endif
+    return p;
+#else
+    return ::operator new(bytes, std::align_val_t{huge_page_size});
+#endif
+}
+
+/// give back memory of map_huge_pages()
+inline void unmap_huge_pages(void* const p, std::size_t const bytes) noexcept
+{
+#if BOSSWESTFALEN_HAS_MMAP
+    ::munmap(p, bytes);
+#else
+    static_cast<void>(bytes);
+    ::operator delete(p, std::align_val_t{huge_page_size});
+#endif
+}
+
+/*!
+ * \brief resize memory of map_huge_pages()
+ *
+ * Where mremap is available, the mapping is resized in place if possible.
+ * Otherwise a new mapping aligned to huge_page_size is made and the old
+ * pages are moved into it without copying.
+ *
+ * \param p memory of map_huge_pages()
+ * \param old_bytes current size, must be a multiple of huge_page_size
+ * \param new_bytes new size, must be a multiple of huge_page_size
+ * \return memory aligned to huge_page_size holding the first
+ *         min(old_bytes, new_bytes) bytes of p
+ * \throw std::bad_alloc if no memory is available, p is unchanged then
+ */
+inline auto remap_huge_pages(void* const p, std::size_t const old_bytes, std::size_t const new_bytes) -> void*
+{
+#if BOSSWESTFALEN_HAS_MMAP and defined(MREMAP_MAYMOVE) and defined(MREMAP_FIXED)
+    if (::mremap(p, old_bytes, new_bytes, 0) not_eq MAP_FAILED)
+    {
+        return p;
+    }
+
+    auto const q = map_huge_pages(new_bytes);
+    if (::mremap(p, old_bytes, old_bytes, MREMAP_MAYMOVE | MREMAP_FIXED, q) == MAP_FAILED)
+    {
+        std::memcpy(q, p, old_bytes);
+        ::munmap(p, old_bytes);
+    }
+    return q;
+#else
+    auto const q = map_huge_pages(new_bytes);
+    std::memcpy(q, p, std::min(old_bytes, new_bytes));
+    unmap_huge_pages(p, old_bytes);
+    return q;
+#endif
+}
+} // namespace detail
+
+
+/*!
+ * \brief Stateless allocator putting large arrays on huge pages.
+ *
+ * Requests of at least Threshold bytes are rounded up to whole huge pages and
+ * mapped via mmap, using explicit huge pages if the system has some reserved
+ * and transparent huge pages (madvise(MADV_HUGEPAGE)) otherwise. Smaller
+ * requests use the global operator new.
+ *
+ * Huge pages reduce TLB misses of random accesses into large arrays.
+ *
+ * \tparam T type of allocated elements
+ * \tparam Threshold minimal size in bytes for huge page backed memory
+ */
+template <typename T, std::size_t Threshold = huge_page_size>
+class huge_page_allocator final
+{
+  public:
+    /// alias for T
+    using value_type = T;
+
+    /// all instances are equal
+    using is_always_equal = std::true_type;
+
+    /// minimal size in bytes for huge page backed memory
+    static constexpr std::size_t threshold = Threshold;
+
+    /// rebind to another element type, keeping the threshold
+    template <typename U>
+    struct rebind
+    {
+        /// rebound allocator
+        using other = huge_page_allocator<U, Threshold>;
+    };
+
+    /// default ctor
+    huge_page_allocator() noexcept = default;
+
+    /// rebind
+    template <typename U>
+    huge_page_allocator(huge_page_allocator<U, Threshold> const&) noexcept
+    {
+    }
+
+    /// check whether n elements are placed on huge pages
+    [[nodiscard]] static constexpr auto uses_huge_pages(std::size_t const n) noexcept -> bool
+    {
+        return n * sizeof(T) >= threshold;
+    }
+
+    /// get memory for n elements
+    [[nodiscard]] auto allocate(std::size_t const n) -> T*
+    {
+        if (n > (std::numeric_limits<std::size_t>::max() - huge_page_size) / sizeof(T))
+        {
+            throw std::bad_array_new_length{};
+        }
+
+        if (uses_huge_pages(n))
+        {
+            return static_cast<T*>(detail::map_huge_pages(detail::round_to_huge_pages(n * sizeof(T))));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+
+    /// get zeroed memory for n elements, mapped huge pages are not touched
+    [[nodiscard]] auto allocate_zeroed(std::size_t const n) -> T*
+    {
+        auto const p = allocate(n);
+        if (not (uses_huge_pages(n) and BOSSWESTFALEN_HAS_MMAP))
+        {
+            std::memset(p, 0, n * sizeof(T));
+        }
+        return p;
+    }
+
+    /*!
+     * \brief resize memory of old_n elements to new_n elements, keeping its bytes
+     *
+     * Huge pages are remapped, so even huge arrays are not copied.
+     *
+     * \return memory holding the bytes of the first min(old_n, new_n) elements
+     * \throw std::bad_alloc if no memory is available, p is unchanged then
+     */
+    [[nodiscard]] auto reallocate(T* const p, std::size_t const old_n, std::size_t const new_n) -> T*
+    {
+        if (uses_huge_pages(old_n) and uses_huge_pages(new_n)
+            and new_n <= (std::numeric_limits<std::size_t>::max() - huge_page_size) / sizeof(T))
+        {
+            auto const old_bytes = detail::round_to_huge_pages(old_n * sizeof(T));
+            auto const new_bytes = detail::round_to_huge_pages(new_n * sizeof(T));
+            return (old_bytes == new_bytes) ? p : static_cast<T*>(detail::remap_huge_pages(p, old_bytes, new_bytes));
+        }
+
+        auto const q = allocate(new_n);
+        std::memcpy(q, p, std::min(old_n, new_n) * sizeof(T));
+        deallocate(p, old_n);
+        return q;
+    }
+
+    /// give back memory of n elements
+    void deallocate(T* const p, std::size_t const n) noexcept
+    {
+        if (uses_huge_pages(n))
+        {
+            detail::unmap_huge_pages(p, detail::round_to_huge_pages(n * sizeof(T)));
+            return;
+        }
+        ::operator delete(p, std::align_val_t{alignof(T)});
+    }
+};
+
+/// all huge_page_allocators are equal
+template <typename T, typename U, std::size_t S>
+constexpr bool operator==(huge_page_allocator<T, S> const&, huge_page_allocator<U, S> const&) noexcept
+{
+    return true;
+}
+
+/// all huge_page_allocators are equal
+template <typename T, typename U, std::size_t S>
+constexpr bool operator!=(huge_page_allocator<T, S> const&, huge_page_allocator<U, S> const&) noexcept
+{
+    return false;
+}
+
+
+/// runtime_array whose large instances are placed on huge pages
+template <typename T, std::size_t Threshold = huge_page_size>
+using huge_page_runtime_array = runtime_array<T, huge_page_allocator<T, Threshold>>;
+
+} // namespace bosswestfalen
+
+#endif
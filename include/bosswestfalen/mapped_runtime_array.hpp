@@ -0,0 +1,523 @@
+/*!
+ * \file mapped_runtime_array.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_MAPPED_RUNTIME_ARRAY_HPP_
+#define BOSSWESTFALEN_MAPPED_RUNTIME_ARRAY_HPP_
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if __has_include(<sys/mman.h>) and __has_include(<fcntl.h>) and __has_include(<unistd.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace bosswestfalen
+{
+/// how a file is mapped by mapped_runtime_array
+enum class map_mode
+{
+    /// elements can only be read, used by mapped_runtime_array<T const>
+    read_only,
+
+    /// changes are private to the array and never written to the file
+    copy_on_write,
+
+    /// changes are written to the file and visible to all processes mapping it
+    shared
+};
+
+
+/*!
+ * \brief Fixed size array, whose elements are the content of a memory mapped file.
+ *
+ * The file is mapped, not copied, so creating the array is cheap and the page
+ * cache is shared between all processes mapping the same file. The number of
+ * elements is the file size divided by sizeof(T), trailing bytes are ignored.
+ *
+ * A file is mapped read only exactly if T is const, so an array of T const
+ * has no access that could write to the pages, and an array of T is always
+ * writable.
+ *
+ * \tparam T Type of stored elements, must be trivially copyable.
+ */
+template <typename T>
+class mapped_runtime_array final
+{
+    static_assert(std::is_trivially_copyable_v<T>, "mapped_runtime_array requires trivially copyable elements");
+
+  public:
+    /// size type
+    using size_type = std::size_t;
+
+    /// alias for T without const
+    using value_type = std::remove_cv_t<T>;
+
+    /// alias for T&
+    using reference = T&;
+
+    /// alias for T const&
+    using const_reference = T const&;
+
+    /// alias for T*
+    using pointer = T*;
+
+    /// alias for T const *;
+    using const_pointer = T const*;
+
+    /// alias for T*
+    using iterator = T*;
+
+    /// alias for T const*
+    using const_iterator = T const*;
+
+    /// alias for T* for reversed iteration
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    /// alias for T const* for reversed iteration
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /// mode used if none is given
+    static constexpr map_mode default_mode = std::is_const_v<T> ? map_mode::read_only : map_mode::copy_on_write;
+
+    /*!
+     * \brief default ctor for empty array
+     *
+     * Create an empty mapped_runtime_array.
+     */
+    mapped_runtime_array() = default;
+
+    /*!
+     * \brief map an existing file
+     *
+     * \param path path of the file
+     * \param mode how the file is mapped, map_mode::read_only exactly if T is const
+     * \throw std::invalid_argument if mode does not match the constness of T
+     * \throw std::system_error if the file cannot be opened or mapped
+     */
+    explicit mapped_runtime_array(std::string const& path,
+                                  map_mode const mode = default_mode)
+        : m_mode{mode}
+    {
+        if ((mode == map_mode::read_only) not_eq std::is_const_v<T>)
+        {
+            throw std::invalid_argument{"map_mode::read_only needs mapped_runtime_array<T const> and vice versa"};
+        }
+        auto const fd = open_file(path, (mode == map_mode::shared) ? O_RDWR : O_RDONLY);
+        struct stat info{};
+        if (::fstat(fd.get(), &info) not_eq 0)
+        {
+            throw_error("fstat " + path);
+        }
+        map(fd.get(), static_cast<size_type>(info.st_size) / sizeof(value_type));
+    }
+
+    /*!
+     * \brief create or resize a file to hold n elements and map it shared
+     *
+     * New parts of the file are filled with zeros.
+     *
+     * \param path path of the file
+     * \param n number of elements
+     * \throw std::system_error if the file cannot be created, resized or mapped
+     */
+    mapped_runtime_array(std::string const& path, size_type const n)
+        : m_mode{map_mode::shared}
+    {
+        static_assert(not std::is_const_v<T>, "a read only mapping cannot create a file");
+
+        auto const fd = open_file(path, O_RDWR | O_CREAT);
+        if (::ftruncate(fd.get(), static_cast<off_t>(n * sizeof(value_type))) not_eq 0)
+        {
+            throw_error("ftruncate " + path);
+        }
+        map(fd.get(), n);
+    }
+
+    /// unmap the file
+    ~mapped_runtime_array()
+    {
+        unmap();
+    }
+
+    /// mappings are not copyable, create a runtime_array from data() and size() instead
+    mapped_runtime_array(mapped_runtime_array const&) = delete;
+
+    /// move construct, orig will be empty
+    mapped_runtime_array(mapped_runtime_array&& orig) noexcept
+        : m_mode{orig.m_mode}
+        , m_size{std::exchange(orig.m_size, 0)}
+        , m_data{std::exchange(orig.m_data, nullptr)}
+    {
+    }
+
+    /// mappings are not copyable
+    mapped_runtime_array& operator=(mapped_runtime_array const&) = delete;
+
+    /// move assign, the old mapping is removed
+    mapped_runtime_array& operator=(mapped_runtime_array&& rhs) noexcept
+    {
+        auto tmp = mapped_runtime_array{std::move(rhs)};
+        swap(tmp);
+        return *this;
+    }
+
+    /// swap with another mapped_runtime_array
+    void swap(mapped_runtime_array& rhs) noexcept
+    {
+        std::swap(m_mode, rhs.m_mode);
+        std::swap(m_size, rhs.m_size);
+        std::swap(m_data, rhs.m_data);
+    }
+
+    /// the mode used to map the file
+    [[nodiscard]] auto mode() const noexcept -> map_mode
+    {
+        return m_mode;
+    }
+
+    /*!
+     * \brief write changes back to the file
+     *
+     * Only needed for map_mode::shared, if the data has to be on disk before
+     * the array is destroyed.
+     *
+     * \throw std::system_error if msync fails
+     */
+    void sync() const
+    {
+        if (m_data not_eq nullptr and ::msync(address(), bytes(), MS_SYNC) not_eq 0)
+        {
+            throw_error("msync");
+        }
+    }
+
+    /// check for emptiness
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /// get number of elements
+    [[nodiscard]] auto size() const noexcept -> size_type
+    {
+        return m_size;
+    }
+
+    /// get direct access to the data
+    [[nodiscard]] auto data() const noexcept -> const_pointer
+    {
+        return m_data;
+    }
+
+    /// \copydoc data()
+    [[nodiscard]] auto data() noexcept -> pointer
+    {
+        return const_cast<pointer>(std::as_const(*this).data());
+    }
+
+    /*!
+     * \brief get reference to specified element
+     *
+     * Returns a reference to the element at specified position.
+     * \note No bounds checking is performed.
+     *
+     * \param pos position of the element
+     * \return reference of the element
+     */
+    [[nodiscard]] auto operator[](size_type const pos) const -> const_reference
+    {
+        return *(data() + pos);
+    }
+
+    /// \copydoc operator[]
+    [[nodiscard]] auto operator[](size_type const pos) -> reference
+    {
+        return const_cast<reference>(std::as_const(*this)[pos]);
+    }
+
+    /*!
+     * \brief get reference to specified element
+     *
+     * Returns a reference to the element at specified position.
+     * \note Bounds checking is performed.
+     *
+     * \param pos position of the element
+     * \return reference of the element
+     */
+    [[nodiscard]] auto at(size_type const pos) const -> const_reference
+    {
+        if (size() <= pos)
+        {
+            throw std::out_of_range{""};
+        }
+        return operator[](pos);
+    }
+
+    /// \copydoc at
+    [[nodiscard]] auto at(size_type const pos) -> reference
+    {
+        return const_cast<reference>(std::as_const(*this).at(pos));
+    }
+
+    /// get reference to the first element
+    [[nodiscard]] auto front() const -> const_reference
+    {
+        return operator[](0);
+    }
+
+    /// \copydoc front
+    [[nodiscard]] auto front() -> reference
+    {
+        return const_cast<reference>(std::as_const(*this).front());
+    }
+
+    /// get reference to the last element
+    [[nodiscard]] auto back() const -> const_reference
+    {
+        return operator[](size() - 1);
+    }
+
+    /// \copydoc back
+    [[nodiscard]] auto back() -> reference
+    {
+        return const_cast<reference>(std::as_const(*this).back());
+    }
+
+    /// get iterator to first element
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator
+    {
+        return data();
+    }
+
+    /// \copydoc cbegin()
+    [[nodiscard]] auto begin() const noexcept -> const_iterator
+    {
+        return cbegin();
+    }
+
+    /// \copydoc begin()
+    [[nodiscard]] auto begin() noexcept -> iterator
+    {
+        return const_cast<iterator>(std::as_const(*this).begin());
+    }
+
+    /// get iterator to the "element" following the last element
+    [[nodiscard]] auto cend() const noexcept -> const_iterator
+    {
+        return (data() + size());
+    }
+
+    /// \copydoc end()
+    [[nodiscard]] auto end() const noexcept -> const_iterator
+    {
+        return cend();
+    }
+
+    /// \copydoc end()
+    [[nodiscard]] auto end() noexcept -> iterator
+    {
+        return const_cast<iterator>(std::as_const(*this).end());
+    }
+
+    /// get reverse iterator to the last element
+    [[nodiscard]] auto crbegin() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{cend()};
+    }
+
+    /// \copydoc crbegin()
+    [[nodiscard]] auto rbegin() const noexcept -> const_reverse_iterator
+    {
+        return crbegin();
+    }
+
+    /// \copydoc rbegin()
+    [[nodiscard]] auto rbegin() noexcept -> reverse_iterator
+    {
+        return reverse_iterator{end()};
+    }
+
+    /// get reverse iterator to the "element" before the first element
+    [[nodiscard]] auto crend() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{cbegin()};
+    }
+
+    /// \copydoc rend()
+    [[nodiscard]] auto rend() const noexcept -> const_reverse_iterator
+    {
+        return crend();
+    }
+
+    /// \copydoc rend()
+    [[nodiscard]] auto rend() noexcept -> reverse_iterator
+    {
+        return reverse_iterator{begin()};
+    }
+
+    /// assign given value to all elements
+    void fill(value_type const& val)
+    {
+        static_assert(not std::is_const_v<T>, "fill of read only mapping");
+        std::fill_n(data(), size(), val);
+    }
+
+  private:
+    /// closes a file descriptor when going out of scope
+    class file_descriptor final
+    {
+      public:
+        /// take ownership of fd
+        explicit file_descriptor(int const fd) noexcept
+            : m_fd{fd}
+        {
+        }
+
+        /// close the file
+        ~file_descriptor()
+        {
+            ::close(m_fd);
+        }
+
+        /// not copyable
+        file_descriptor(file_descriptor const&) = delete;
+
+        /// not copyable
+        file_descriptor& operator=(file_descriptor const&) = delete;
+
+        /// the file descriptor
+        [[nodiscard]] auto get() const noexcept -> int
+        {
+            return m_fd;
+        }
+
+      private:
+        /// the file descriptor
+        int m_fd;
+    };
+
+    /// throw std::system_error for errno
+    [[noreturn]] static void throw_error(std::string const& what)
+    {
+        throw std::system_error{errno, std::generic_category(), what};
+    }
+
+    /// open path with flags
+    static auto open_file(std::string const& path, int const flags) -> file_descriptor
+    {
+        auto const fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+            throw_error("open " + path);
+        }
+        return file_descriptor{fd};
+    }
+
+    /// address of the mapping for the system calls
+    [[nodiscard]] auto address() const noexcept -> void*
+    {
+        return const_cast<value_type*>(m_data);
+    }
+
+    /// size of the mapping in bytes
+    [[nodiscard]] auto bytes() const noexcept -> size_type
+    {
+        return m_size * sizeof(value_type);
+    }
+
+    /// map n elements of the file, nothing is mapped for n == 0
+    void map(int const fd, size_type const n)
+    {
+        if (n == 0)
+        {
+            return;
+        }
+
+        auto const protection = (m_mode == map_mode::read_only) ? PROT_READ : (PROT_READ | PROT_WRITE);
+        auto const flags = (m_mode == map_mode::shared) ? MAP_SHARED : MAP_PRIVATE;
+        auto const p = ::mmap(nullptr, n * sizeof(value_type), protection, flags, fd, 0);
+        if (p == MAP_FAILED)
+        {
+            throw_error("mmap");
+        }
+        m_size = n;
+        m_data = static_cast<pointer>(p);
+    }
+
+    /// remove the mapping
+    void unmap() noexcept
+    {
+        if (m_data not_eq nullptr)
+        {
+            ::munmap(address(), bytes());
+        }
+    }
+
+    /// how the file is mapped
+    map_mode m_mode{default_mode};
+
+    /// number of elements
+    size_type m_size{0};
+
+    /// the mapped elements
+    pointer m_data{nullptr};
+};
+
+
+/// compare whether equal
+template <typename T>
+bool operator==(mapped_runtime_array<T> const& lhs, mapped_runtime_array<T> const& rhs)
+{
+    if (lhs.size() not_eq rhs.size())
+    {
+        return false;
+    }
+
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+/// compare whether not equal
+template <typename T>
+bool operator!=(mapped_runtime_array<T> const& lhs, mapped_runtime_array<T> const& rhs)
+{
+    return not (lhs == rhs);
+}
+
+/// check whether lhs < rhs
+template <typename T>
+bool operator<(mapped_runtime_array<T> const& lhs, mapped_runtime_array<T> const& rhs)
+{
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+
+/// free function swap, same as mapped_runtime_array::swap
+template <typename T>
+void swap(mapped_runtime_array<T>& lhs, mapped_runtime_array<T>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace bosswestfalen
+
+#endif
+
+#endif
@@ -0,0 +1,860 @@
+/*!
+ * \file mdspan.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_MDSPAN_HPP_
+#define BOSSWESTFALEN_MDSPAN_HPP_
+
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace bosswestfalen
+{
+/// marks an extent that is only known at runtime
+inline constexpr std::size_t dynamic_extent = std::numeric_limits<std::size_t>::max();
+
+
+/*!
+ * \brief extents of a multi-dimensional array
+ *
+ * Each extent is either known at compile time or dynamic_extent, in which
+ * case it is stored in the object. Static extents cost neither memory nor
+ * loads in the index computation.
+ *
+ * \tparam E extent of each dimension, or dynamic_extent
+ */
+template <std::size_t... E>
+class extents final
+{
+  public:
+    /// size type
+    using size_type = std::size_t;
+
+    /// type of dimension indices
+    using rank_type = std::size_t;
+
+    /// number of dimensions
+    [[nodiscard]] static constexpr auto rank() noexcept -> rank_type
+    {
+        return sizeof...(E);
+    }
+
+    /// number of dimensions with dynamic extent
+    [[nodiscard]] static constexpr auto rank_dynamic() noexcept -> rank_type
+    {
+        return (rank_type{0} + ... + rank_type{E == dynamic_extent});
+    }
+
+    /// compile time extent of dimension r, or dynamic_extent
+    [[nodiscard]] static constexpr auto static_extent(rank_type const r) noexcept -> size_type
+    {
+        return static_extents[r];
+    }
+
+    /// dynamic extents are 0
+    constexpr extents() noexcept = default;
+
+    /// create from the dynamic extents only, or from all extents
+    template <typename... Sizes,
+              typename = std::enable_if_t<(sizeof...(Sizes) > 0)
+                                          and (sizeof...(Sizes) == rank_dynamic() or sizeof...(Sizes) == rank())
+                                          and (... and std::is_convertible_v<Sizes, size_type>)>>
+    constexpr explicit extents(Sizes const... sizes) noexcept
+        : extents(std::array<size_type, sizeof...(Sizes)>{static_cast<size_type>(sizes)...})
+    {
+    }
+
+    /// create from the dynamic extents only, or from all extents
+    template <std::size_t N, typename = std::enable_if_t<N == rank_dynamic() or N == rank()>>
+    constexpr explicit extents(std::array<size_type, N> const& sizes) noexcept
+    {
+        if constexpr (N == rank_dynamic())
+        {
+            m_dynamic = sizes;
+        }
+        else
+        {
+            for (auto r = rank_type{0}; r < rank(); ++r)
+            {
+                if (static_extents[r] == dynamic_extent)
+                {
+                    m_dynamic[dynamic_index[r]] = sizes[r];
+                }
+            }
+        }
+    }
+
+    /// convert from extents with the same rank, static extents must match
+    template <std::size_t... F,
+              typename = std::enable_if_t<sizeof...(F) == sizeof...(E)
+                                          and (... and (E == dynamic_extent or F == dynamic_extent or E == F))>>
+    constexpr extents(extents<F...> const& other) noexcept
+    {
+        for (auto r = rank_type{0}; r < rank(); ++r)
+        {
+            if (static_extents[r] == dynamic_extent)
+            {
+                m_dynamic[dynamic_index[r]] = other.extent(r);
+            }
+        }
+    }
+
+    /// get extent of dimension r
+    [[nodiscard]] constexpr auto extent(rank_type const r) const noexcept -> size_type
+    {
+        if constexpr (rank_dynamic() == 0)
+        {
+            return static_extents[r];
+        }
+        else
+        {
+            return (static_extents[r] == dynamic_extent) ? m_dynamic[dynamic_index[r]] : static_extents[r];
+        }
+    }
+
+    /// get product of the extents of dimensions [first, last)
+    [[nodiscard]] constexpr auto product(rank_type const first, rank_type const last) const noexcept -> size_type
+    {
+        auto result = size_type{1};
+        for (auto r = first; r < last; ++r)
+        {
+            result *= extent(r);
+        }
+        return result;
+    }
+
+  private:
+    /// extents known at compile time
+    static constexpr std::array<size_type, sizeof...(E)> static_extents{E...};
+
+    /// position of each dynamic extent in m_dynamic
+    static constexpr std::array<size_type, sizeof...(E)> dynamic_index = []() {
+        auto index = std::array<size_type, sizeof...(E)>{};
+        auto next = size_type{0};
+        for (auto r = rank_type{0}; r < sizeof...(E); ++r)
+        {
+            index[r] = next;
+            next += (static_extents[r] == dynamic_extent) ? 1 : 0;
+        }
+        return index;
+    }();
+
+    /// dynamic extents
+    std::array<size_type, rank_dynamic()> m_dynamic{};
+};
+
+/// extents are equal, if every dimension has the same extent
+template <std::size_t... E, std::size_t... F>
+constexpr bool operator==(extents<E...> const& lhs, extents<F...> const& rhs) noexcept
+{
+    if constexpr (sizeof...(E) not_eq sizeof...(F))
+    {
+        return false;
+    }
+    else
+    {
+        for (auto r = std::size_t{0}; r < sizeof...(E); ++r)
+        {
+            if (lhs.extent(r) not_eq rhs.extent(r))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/// extents are equal, if every dimension has the same extent
+template <std::size_t... E, std::size_t... F>
+constexpr bool operator!=(extents<E...> const& lhs, extents<F...> const& rhs) noexcept
+{
+    return not (lhs == rhs);
+}
+
+
+namespace detail
+{
+/// extents with Rank dynamic extents
+template <typename Sequence>
+struct make_dextents;
+
+/// \copydoc make_dextents
+template <std::size_t... I>
+struct make_dextents<std::index_sequence<I...>>
+{
+    /// the extents
+    using type = extents<(static_cast<void>(I), dynamic_extent)...>;
+};
+
+/// check whether indices are within extents
+template <typename Extents, typename... Indices>
+constexpr bool in_bounds(Extents const& e, Indices const... indices) noexcept
+{
+    auto const index = std::array<std::size_t, sizeof...(Indices)>{static_cast<std::size_t>(indices)...};
+    for (auto r = std::size_t{0}; r < sizeof...(Indices); ++r)
+    {
+        if (index[r] >= e.extent(r))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace detail
+
+/// extents of Rank dimensions, all known at runtime only
+template <std::size_t Rank>
+using dextents = typename detail::make_dextents<std::make_index_sequence<Rank>>::type;
+
+
+/*!
+ * \brief row-major layout, the last index is contiguous
+ *
+ * The layout of C arrays, element (i, j) of a matrix is at i * cols + j.
+ */
+struct layout_right
+{
+    /// maps indices to offsets
+    template <typename Extents>
+    class mapping final
+    {
+      public:
+        /// type of extents
+        using extents_type = Extents;
+
+        /// size type
+        using size_type = typename Extents::size_type;
+
+        /// type of dimension indices
+        using rank_type = typename Extents::rank_type;
+
+        /// the layout
+        using layout_type = layout_right;
+
+        /// mapping of empty extents
+        constexpr mapping() noexcept = default;
+
+        /// mapping of given extents
+        constexpr mapping(extents_type const& e) noexcept
+            : m_extents{e}
+        {
+        }
+
+        /// convert from mapping of convertible extents
+        template <typename OtherExtents, typename = std::enable_if_t<std::is_convertible_v<OtherExtents, extents_type>>>
+        constexpr mapping(mapping<OtherExtents> const& other) noexcept
+            : m_extents{other.extents()}
+        {
+        }
+
+        /// get extents
+        [[nodiscard]] constexpr auto extents() const noexcept -> extents_type const&
+        {
+            return m_extents;
+        }
+
+        /// get offset of element (indices...)
+        template <typename... Indices>
+        [[nodiscard]] constexpr auto operator()(Indices const... indices) const noexcept -> size_type
+        {
+            static_assert(sizeof...(Indices) == extents_type::rank(), "one index per dimension required");
+            auto const index = std::array<size_type, sizeof...(Indices)>{static_cast<size_type>(indices)...};
+            auto offset = size_type{0};
+            for (auto r = rank_type{0}; r < extents_type::rank(); ++r)
+            {
+                offset = offset * m_extents.extent(r) + index[r];
+            }
+            return offset;
+        }
+
+        /// get number of elements the mapped memory must provide
+        [[nodiscard]] constexpr auto required_span_size() const noexcept -> size_type
+        {
+            return m_extents.product(0, extents_type::rank());
+        }
+
+        /// get distance between neighbours in dimension r
+        [[nodiscard]] constexpr auto stride(rank_type const r) const noexcept -> size_type
+        {
+            return m_extents.product(r + 1, extents_type::rank());
+        }
+
+        /// every element has its own offset
+        [[nodiscard]] static constexpr auto is_always_unique() noexcept -> bool
+        {
+            return true;
+        }
+
+        /// offsets are [0, required_span_size())
+        [[nodiscard]] static constexpr auto is_always_exhaustive() noexcept -> bool
+        {
+            return true;
+        }
+
+        /// offsets are a weighted sum of the indices
+        [[nodiscard]] static constexpr auto is_always_strided() noexcept -> bool
+        {
+            return true;
+        }
+
+        /// mappings are equal, if their extents are equal
+        friend constexpr bool operator==(mapping const& lhs, mapping const& rhs) noexcept
+        {
+            return lhs.extents() == rhs.extents();
+        }
+
+        /// mappings are equal, if their extents are equal
+        friend constexpr bool operator!=(mapping const& lhs, mapping const& rhs) noexcept
+        {
+            return not (lhs == rhs);
+        }
+
+      private:
+        /// the extents
+        extents_type m_extents{};
+    };
+};
+
+
+/*!
+ * \brief column-major layout, the first index is contiguous
+ *
+ * The layout of Fortran arrays, element (i, j) of a matrix is at
+ * j * rows + i.
+ */
+struct layout_left
+{
+    /// maps indices to offsets
+    template <typename Extents>
+    class mapping final
+    {
+      public:
+        /// type of extents
+        using extents_type = Extents;
+
+        /// size type
+        using size_type = typename Extents::size_type;
+
+        /// type of dimension indices
+        using rank_type = typename Extents::rank_type;
+
+        /// the layout
+        using layout_type = layout_left;
+
+        /// mapping of empty extents
+        constexpr mapping() noexcept = default;
+
+        /// mapping of given extents
+        constexpr mapping(extents_type const& e) noexcept
+            : m_extents{e}
+        {
+        }
+
+        /// convert from mapping of convertible extents
+        template <typename OtherExtents, typename = std::enable_if_t<std::is_convertible_v<OtherExtents, extents_type>>>
+        constexpr mapping(mapping<OtherExtents> const& other) noexcept
+            : m_extents{other.extents()}
+        {
+        }
+
+        /// get extents
+        [[nodiscard]] constexpr auto extents() const noexcept -> extents_type const&
+        {
+            return m_extents;
+        }
+
+        /// get offset of element (indices...)
+        template <typename... Indices>
+        [[nodiscard]] constexpr auto operator()(Indices const... indices) const noexcept -> size_type
+        {
+            static_assert(sizeof...(Indices) == extents_type::rank(), "one index per dimension required");
+            auto const index = std::array<size_type, sizeof...(Indices)>{static_cast<size_type>(indices)...};
+            auto offset = size_type{0};
+            for (auto r = extents_type::rank(); r > 0; --r)
+            {
+                offset = offset * m_extents.extent(r - 1) + index[r - 1];
+            }
+            return offset;
+        }
+
+        /// get number of elements the mapped memory must provide
+        [[nodiscard]] constexpr auto required_span_size() const noexcept -> size_type
+        {
+            return m_extents.product(0, extents_type::rank());
+        }
+
+        /// get distance between neighbours in dimension r
+        [[nodiscard]] constexpr auto stride(rank_type const r) const noexcept -> size_type
+        {
+            return m_extents.product(0, r);
+        }
+
+        /// every element has its own offset
+        [[nodiscard]] static constexpr auto is_always_unique() noexcept -> bool
+        {
+            return true;
+        }
+
+        /// offsets are [0, required_span_size())
+        [[nodiscard]] static constexpr auto is_always_exhaustive() noexcept -> bool
+        {
+            return true;
+        }
+
+        /// offsets are a weighted sum of the indices
+        [[nodiscard]] static constexpr auto is_always_strided() noexcept -> bool
+        {
+            return true;
+        }
+
+        /// mappings are equal, if their extents are equal
+        friend constexpr bool operator==(mapping const& lhs, mapping const& rhs) noexcept
+        {
+            return lhs.extents() == rhs.extents();
+        }
+
+        /// mappings are equal, if their extents are equal
+        friend constexpr bool operator!=(mapping const& lhs, mapping const& rhs) noexcept
+        {
+            return not (lhs == rhs);
+        }
+
+      private:
+        /// the extents
+        extents_type m_extents{};
+    };
+};
+
+
+/*!
+ * \brief layout with arbitrary stride per dimension
+ *
+ * Used for sub-blocks of other layouts, see submdspan.
+ */
+struct layout_stride
+{
+    /// maps indices to offsets
+    template <typename Extents>
+    class mapping final
+    {
+      public:
+        /// type of extents
+        using extents_type = Extents;
+
+        /// size type
+        using size_type = typename Extents::size_type;
+
+        /// type of dimension indices
+        using rank_type = typename Extents::rank_type;
+
+        /// the layout
+        using layout_type = layout_stride;
+
+        /// strides of all dimensions
+        using strides_type = std::array<size_type, extents_type::rank()>;
+
+        /// mapping of empty extents
+        constexpr mapping() noexcept = default;
+
+        /// mapping of given extents and strides
+        constexpr mapping(extents_type const& e, strides_type const& strides) noexcept
+            : m_extents{e}
+            , m_strides{strides}
+        {
+        }
+
+        /// convert from any strided mapping of convertible extents
+        template <typename Mapping,
+                  typename = std::enable_if_t<Mapping::is_always_strided()
+                                              and std::is_convertible_v<typename Mapping::extents_type, extents_type>>>
+        constexpr mapping(Mapping const& other) noexcept
+            : m_extents{other.extents()}
+        {
+            for (auto r = rank_type{0}; r < extents_type::rank(); ++r)
+            {
+                m_strides[r] = other.stride(r);
+            }
+        }
+
+        /// get extents
+        [[nodiscard]] constexpr auto extents() const noexcept -> extents_type const&
+        {
+            return m_extents;
+        }
+
+        /// get strides
+        [[nodiscard]] constexpr auto strides() const noexcept -> strides_type const&
+        {
+            return m_strides;
+        }
+
+        /// get offset of element (indices...)
+        template <typename... Indices>
+        [[nodiscard]] constexpr auto operator()(Indices const... indices) const noexcept -> size_type
+        {
+            static_assert(sizeof...(Indices) == extents_type::rank(), "one index per dimension required");
+            auto const index = std::array<size_type, sizeof...(Indices)>{static_cast<size_type>(indices)...};
+            auto offset = size_type{0};
+            for (auto r = rank_type{0}; r < extents_type::rank(); ++r)
+            {
+                offset += index[r] * m_strides[r];
+            }
+            return offset;
+        }
+
+        /// get number of elements the mapped memory must provide
+        [[nodiscard]] constexpr auto required_span_size() const noexcept -> size_type
+        {
+            auto last = size_type{0};
+            for (auto r = rank_type{0}; r < extents_type::rank(); ++r)
+            {
+                if (m_extents.extent(r) == 0)
+                {
+                    return 0;
+                }
+                last += (m_extents.extent(r) - 1) * m_strides[r];
+            }
+            return last + 1;
+        }
+
+        /// get distance between neighbours in dimension r
+        [[nodiscard]] constexpr auto stride(rank_type const r) const noexcept -> size_type
+        {
+            return m_strides[r];
+        }
+
+        /// strides may overlap
+        [[nodiscard]] static constexpr auto is_always_unique() noexcept -> bool
+        {
+            return false;
+        }
+
+        /// strides may leave gaps
+        [[nodiscard]] static constexpr auto is_always_exhaustive() noexcept -> bool
+        {
+            return false;
+        }
+
+        /// offsets are a weighted sum of the indices
+        [[nodiscard]] static constexpr auto is_always_strided() noexcept -> bool
+        {
+            return true;
+        }
+
+        /// mappings are equal, if their extents and strides are equal
+        friend constexpr bool operator==(mapping const& lhs, mapping const& rhs) noexcept
+        {
+            return lhs.extents() == rhs.extents() and lhs.strides() == rhs.strides();
+        }
+
+        /// mappings are equal, if their extents and strides are equal
+        friend constexpr bool operator!=(mapping const& lhs, mapping const& rhs) noexcept
+        {
+            return not (lhs == rhs);
+        }
+
+      private:
+        /// the extents
+        extents_type m_extents{};
+
+        /// distance between neighbours in each dimension
+        strides_type m_strides{};
+    };
+};
+
+
+/*!
+ * \brief non-owning multi-dimensional view on contiguous memory
+ *
+ * Element (indices...) is data()[mapping()(indices...)]. The layout decides
+ * which index is contiguous in memory, so it decides which loop order is
+ * cache-friendly: iterate the last index innermost for layout_right, the
+ * first for layout_left.
+ *
+ * \tparam T type of the elements, const for read-only access
+ * \tparam Extents extents of the dimensions, see extents and dextents
+ * \tparam Layout layout_right, layout_left, layout_stride or any type with a
+ *         compatible mapping template
+ */
+template <typename T, typename Extents, typename Layout = layout_right>
+class mdspan final
+{
+  public:
+    /// type of extents
+    using extents_type = Extents;
+
+    /// the layout
+    using layout_type = Layout;
+
+    /// maps indices to offsets
+    using mapping_type = typename Layout::template mapping<Extents>;
+
+    /// type of the elements
+    using element_type = T;
+
+    /// type of the elements without const
+    using value_type = std::remove_cv_t<T>;
+
+    /// size type
+    using size_type = typename Extents::size_type;
+
+    /// type of dimension indices
+    using rank_type = typename Extents::rank_type;
+
+    /// pointer to an element
+    using pointer = T*;
+
+    /// reference to an element
+    using reference = T&;
+
+    /// number of dimensions
+    [[nodiscard]] static constexpr auto rank() noexcept -> rank_type
+    {
+        return extents_type::rank();
+    }
+
+    /// number of dimensions with dynamic extent
+    [[nodiscard]] static constexpr auto rank_dynamic() noexcept -> rank_type
+    {
+        return extents_type::rank_dynamic();
+    }
+
+    /// compile time extent of dimension r, or dynamic_extent
+    [[nodiscard]] static constexpr auto static_extent(rank_type const r) noexcept -> size_type
+    {
+        return extents_type::static_extent(r);
+    }
+
+    /// empty view
+    constexpr mdspan() noexcept = default;
+
+    /// view on p with the dynamic extents, or all extents, given
+    template <typename... Sizes,
+              typename = std::enable_if_t<(sizeof...(Sizes) == rank_dynamic() or sizeof...(Sizes) == rank())
+                                          and (... and std::is_convertible_v<Sizes, size_type>)
+                                          and std::is_constructible_v<mapping_type, extents_type>>>
+    constexpr explicit mdspan(pointer const p, Sizes const... sizes) noexcept
+        : m_data{p}
+        , m_mapping{extents_type(static_cast<size_type>(sizes)...)}
+    {
+    }
+
+    /// view on p with given extents
+    template <typename E = extents_type, typename = std::enable_if_t<std::is_constructible_v<mapping_type, E>>>
+    constexpr mdspan(pointer const p, extents_type const& e) noexcept
+        : m_data{p}
+        , m_mapping{e}
+    {
+    }
+
+    /// view on p with given mapping
+    constexpr mdspan(pointer const p, mapping_type const& m) noexcept
+        : m_data{p}
+        , m_mapping{m}
+    {
+    }
+
+    /// convert from view with convertible elements and mapping, e.g. to const elements or dynamic extents
+    template <typename U, typename OtherExtents, typename OtherLayout,
+              typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>
+                                          and std::is_constructible_v<mapping_type, typename mdspan<U, OtherExtents, OtherLayout>::mapping_type>>>
+    constexpr mdspan(mdspan<U, OtherExtents, OtherLayout> const& other) noexcept
+        : m_data{other.data()}
+        , m_mapping{other.mapping()}
+    {
+    }
+
+    /// get element (indices...), no bounds checking is performed
+    template <typename... Indices>
+    [[nodiscard]] constexpr auto operator()(Indices const... indices) const -> reference
+    {
+        return m_data[m_mapping(indices...)];
+    }
+
+    /// get element at given indices, no bounds checking is performed
+    [[nodiscard]] constexpr auto operator()(std::array<size_type, rank()> const& indices) const -> reference
+    {
+        return std::apply(*this, indices);
+    }
+
+    /*!
+     * \brief get element (indices...) with bounds checking
+     *
+     * \throw std::out_of_range if an index is not less than its extent
+     */
+    template <typename... Indices>
+    [[nodiscard]] constexpr auto at(Indices const... indices) const -> reference
+    {
+        static_assert(sizeof...(Indices) == rank(), "one index per dimension required");
+        if (not detail::in_bounds(extents(), indices...))
+        {
+            throw std::out_of_range{""};
+        }
+        return operator()(indices...);
+    }
+
+    /// get extents
+    [[nodiscard]] constexpr auto extents() const noexcept -> extents_type const&
+    {
+        return m_mapping.extents();
+    }
+
+    /// get extent of dimension r
+    [[nodiscard]] constexpr auto extent(rank_type const r) const noexcept -> size_type
+    {
+        return extents().extent(r);
+    }
+
+    /// get number of elements
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type
+    {
+        return extents().product(0, rank());
+    }
+
+    /// check for emptiness
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /// get distance between neighbours in dimension r, for strided layouts
+    [[nodiscard]] constexpr auto stride(rank_type const r) const noexcept -> size_type
+    {
+        return m_mapping.stride(r);
+    }
+
+    /// get pointer to the viewed memory
+    [[nodiscard]] constexpr auto data() const noexcept -> pointer
+    {
+        return m_data;
+    }
+
+    /// get mapping
+    [[nodiscard]] constexpr auto mapping() const noexcept -> mapping_type const&
+    {
+        return m_mapping;
+    }
+
+  private:
+    /// viewed memory
+    pointer m_data{nullptr};
+
+    /// maps indices to offsets
+    mapping_type m_mapping{};
+};
+
+
+/// select all indices of a dimension in submdspan
+struct full_extent_t
+{
+    /// tag type
+    explicit full_extent_t() = default;
+};
+
+/// \copydoc full_extent_t
+inline constexpr full_extent_t full_extent{};
+
+
+namespace detail
+{
+/// check whether slice S keeps its dimension, i.e. is not a single index
+template <typename S>
+inline constexpr bool keeps_dimension = not std::is_convertible_v<S, std::size_t>;
+
+/// first index selected by a slice
+template <typename S>
+constexpr auto slice_first(S const& slice) noexcept -> std::size_t
+{
+    if constexpr (std::is_same_v<S, full_extent_t>)
+    {
+        return 0;
+    }
+    else if constexpr (keeps_dimension<S>)
+    {
+        return static_cast<std::size_t>(std::get<0>(slice));
+    }
+    else
+    {
+        return static_cast<std::size_t>(slice);
+    }
+}
+
+/// number of indices selected by a slice of a dimension with given extent
+template <typename S>
+constexpr auto slice_extent(S const& slice, std::size_t const extent) noexcept -> std::size_t
+{
+    if constexpr (std::is_same_v<S, full_extent_t>)
+    {
+        return extent;
+    }
+    else
+    {
+        return static_cast<std::size_t>(std::get<1>(slice)) - static_cast<std::size_t>(std::get<0>(slice));
+    }
+}
+} // namespace detail
+
+
+/*!
+ * \brief view on a sub-block of a strided view, without copying
+ *
+ * One slice per dimension of view:
+ * - an index selects a single position and removes the dimension,
+ * - a pair {first, last} selects [first, last),
+ * - full_extent selects the whole dimension.
+ *
+ * \code
+ * auto const block = submdspan(image, std::pair{10, 20}, full_extent);  // rows 10 to 19
+ * auto const row = submdspan(image, 5, full_extent);                    // row 5 as 1-d view
+ * \endcode
+ *
+ * \return view with one dimension per pair or full_extent and layout_stride
+ */
+template <typename T, typename Extents, typename Layout, typename... Slices>
+[[nodiscard]] constexpr auto submdspan(mdspan<T, Extents, Layout> const& view, Slices const... slices)
+{
+    using view_type = mdspan<T, Extents, Layout>;
+    static_assert(sizeof...(Slices) == view_type::rank(), "one slice per dimension required");
+    static_assert(view_type::mapping_type::is_always_strided(), "only strided layouts can be sliced");
+
+    constexpr auto sub_rank = (std::size_t{0} + ... + std::size_t{detail::keeps_dimension<Slices>});
+    using sub_extents_type = dextents<sub_rank>;
+    using sub_mapping_type = layout_stride::mapping<sub_extents_type>;
+
+    auto sub_extents = std::array<std::size_t, sub_rank>{};
+    auto sub_strides = typename sub_mapping_type::strides_type{};
+    auto offset = std::size_t{0};
+    auto r = std::size_t{0};
+    auto s = std::size_t{0};
+
+    auto const apply = [&](auto const& slice) {
+        offset += detail::slice_first(slice) * view.stride(r);
+        if constexpr (detail::keeps_dimension<std::decay_t<decltype(slice)>>)
+        {
+            sub_extents[s] = detail::slice_extent(slice, view.extent(r));
+            sub_strides[s] = view.stride(r);
+            ++s;
+        }
+        ++r;
+    };
+    (apply(slices), ...);
+
+    return mdspan<T, sub_extents_type, layout_stride>(view.data() + offset,
+                                                      sub_mapping_type{sub_extents_type{sub_extents}, sub_strides});
+}
+
+} // namespace bosswestfalen
+
+#endif
@@ -0,0 +1,327 @@
+/*!
+ * \file numa_allocator.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_NUMA_ALLOCATOR_HPP_
+#define BOSSWESTFALEN_NUMA_ALLOCATOR_HPP_
+
+
+#include "bosswestfalen/page_allocator.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#if __has_include(<linux/mempolicy.h>) and __has_include(<sys/syscall.h>) and __has_include(<unistd.h>)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// MPOL_BIND and MPOL_INTERLEAVE are enumerators, not macros
+#if defined(__linux__) and defined(SYS_mbind)
+#define BOSSWESTFALEN_HAS_MBIND 1
+#else
+#define BOSSWESTFALEN_HAS_MBIND 0
+#endif
+
+
+namespace bosswestfalen
+{
+namespace detail
+{
+/// parse a node list like "0-1,3" into a bit mask, nodes above 63 are dropped
+inline auto parse_node_list(std::istream& in) -> std::uint64_t
+{
+    auto mask = std::uint64_t{0};
+    auto first = 0u;
+    while (in >> first)
+    {
+        auto last = first;
+        if (in.peek() == '-')
+        {
+            in.get();
+            in >> last;
+        }
+        for (auto node = first; node <= last and node < 64; ++node)
+        {
+            mask |= std::uint64_t{1} << node;
+        }
+        if (in.peek() == ',')
+        {
+            in.get();
+        }
+    }
+    return mask;
+}
+} // namespace detail
+
+
+/*!
+ * \brief mask of the NUMA nodes that are online
+ *
+ * Bit i stands for node i. Systems without NUMA information report node 0.
+ */
+inline auto numa_online_nodes() noexcept -> std::uint64_t
+{
+    static auto const mask = []() noexcept {
+        auto nodes = std::uint64_t{0};
+        try
+        {
+            auto file = std::ifstream{"/sys/devices/system/node/online"};
+            nodes = detail::parse_node_list(file);
+        }
+        catch (...)
+        {
+        }
+        return (nodes == 0) ? std::uint64_t{1} : nodes;
+    }();
+    return mask;
+}
+
+
+/// number of NUMA nodes that are online
+inline auto numa_node_count() noexcept -> std::size_t
+{
+    auto count = std::size_t{0};
+    for (auto mask = numa_online_nodes(); mask not_eq 0; mask &= mask - 1)
+    {
+        ++count;
+    }
+    return count;
+}
+
+
+/// where the pages of an array are placed on a NUMA system
+enum class numa_placement
+{
+    /// each page is placed on the node of the thread that touches it first
+    first_touch,
+
+    /// all pages are placed on the given nodes
+    bind,
+
+    /// pages are distributed round-robin across the given nodes
+    interleave
+};
+
+
+/*!
+ * \brief placement of the pages of an array on NUMA nodes
+ *
+ * Nodes are given as bit mask, bit i stands for node i. Only the first 64
+ * nodes can be used.
+ */
+class numa_policy final
+{
+  public:
+    /// mask of all nodes
+    static constexpr std::uint64_t all_nodes = std::numeric_limits<std::uint64_t>::max();
+
+    /// default: first touch
+    constexpr numa_policy() noexcept = default;
+
+    /// pages are placed on the node of the thread that touches them first
+    [[nodiscard]] static constexpr auto first_touch() noexcept -> numa_policy
+    {
+        return numa_policy{numa_placement::first_touch, 0};
+    }
+
+    /*!
+     * \brief all pages are placed on node
+     *
+     * \throw std::invalid_argument if node is not one of the first 64 nodes
+     */
+    [[nodiscard]] static constexpr auto bind(unsigned const node) -> numa_policy
+    {
+        if (node >= 64)
+        {
+            throw std::invalid_argument{"numa_policy: only nodes 0 to 63 can be used"};
+        }
+        return numa_policy{numa_placement::bind, std::uint64_t{1} << node};
+    }
+
+    /// pages are distributed round-robin across the nodes in mask
+    [[nodiscard]] static constexpr auto interleave(std::uint64_t const mask = all_nodes) noexcept -> numa_policy
+    {
+        return numa_policy{numa_placement::interleave, mask};
+    }
+
+    /// the placement
+    [[nodiscard]] constexpr auto placement() const noexcept -> numa_placement
+    {
+        return m_placement;
+    }
+
+    /// the used nodes
+    [[nodiscard]] constexpr auto nodes() const noexcept -> std::uint64_t
+    {
+        return m_nodes;
+    }
+
+    /*!
+     * \brief apply the policy to memory that has not been touched yet
+     *
+     * Does nothing where mbind is not available. The placement is a hint:
+     * errors, e.g. for nodes that do not exist, are ignored.
+     */
+    void apply(void* const p, std::size_t const bytes) const noexcept
+    {
+#if BOSSWESTFALEN_HAS_MBIND
+        if (m_placement == numa_placement::first_touch)
+        {
+            return;
+        }
+
+        auto mask = static_cast<unsigned long>(m_nodes & numa_online_nodes());
+        if (mask == 0)
+        {
+            return;
+        }
+        auto const mode = (m_placement == numa_placement::bind) ? MPOL_BIND : MPOL_INTERLEAVE;
+        ::syscall(SYS_mbind, p, bytes, mode, &mask, sizeof(mask) * 8 + 1, 0);
+#else
+        static_cast<void>(p);
+        static_cast<void>(bytes);
+#endif
+    }
+
+  private:
+    /// create policy
+    constexpr numa_policy(numa_placement const placement, std::uint64_t const nodes) noexcept
+        : m_placement{placement}
+        , m_nodes{nodes}
+    {
+    }
+
+    /// the placement
+    numa_placement m_placement{numa_placement::first_touch};
+
+    /// the used nodes
+    std::uint64_t m_nodes{0};
+};
+
+/// policies are equal, if they place pages equally
+constexpr bool operator==(numa_policy const& lhs, numa_policy const& rhs) noexcept
+{
+    return lhs.placement() == rhs.placement() and lhs.nodes() == rhs.nodes();
+}
+
+/// policies are equal, if they place pages equally
+constexpr bool operator!=(numa_policy const& lhs, numa_policy const& rhs) noexcept
+{
+    return not (lhs == rhs);
+}
+
+
+/*!
+ * \brief Allocator placing arrays on NUMA nodes according to a numa_policy.
+ *
+ * Memory is mapped as fresh pages, so no page is placed before it is touched
+ * or bound. For first_touch, create the array with for_overwrite and let
+ * each worker write its own part, or use the parallel ctors of runtime_array,
+ * which construct each chunk on its own thread.
+ *
+ * The policy only affects placement, all instances can release the memory of
+ * each other, hence is_always_equal.
+ *
+ * \note Every array occupies whole pages, use it for large arrays.
+ *
+ * \tparam T type of allocated elements
+ */
+template <typename T>
+class numa_allocator final
+{
+  public:
+    /// alias for T
+    using value_type = T;
+
+    /// all instances can release the memory of each other
+    using is_always_equal = std::true_type;
+
+    /// create allocator with first touch policy
+    numa_allocator() noexcept = default;
+
+    /// create allocator with given policy
+    numa_allocator(numa_policy const policy) noexcept
+        : m_policy{policy}
+    {
+    }
+
+    /// rebind
+    template <typename U>
+    numa_allocator(numa_allocator<U> const& other) noexcept
+        : m_policy{other.policy()}
+    {
+    }
+
+    /// the used policy
+    [[nodiscard]] auto policy() const noexcept -> numa_policy
+    {
+        return m_policy;
+    }
+
+    /// get memory for n elements, placed according to the policy
+    [[nodiscard]] auto allocate(std::size_t const n) -> T*
+    {
+        if (n > (std::numeric_limits<std::size_t>::max() - detail::page_size()) / sizeof(T))
+        {
+            throw std::bad_array_new_length{};
+        }
+
+        auto const bytes = detail::round_to_pages(n * sizeof(T));
+        auto const p = detail::map_pages(bytes);
+        m_policy.apply(p, bytes);
+        return static_cast<T*>(p);
+    }
+
+    /// fresh pages are zeroed already
+    [[nodiscard]] auto allocate_zeroed(std::size_t const n) -> T*
+    {
+        return allocate(n);
+    }
+
+    /// give back memory of n elements
+    void deallocate(T* const p, std::size_t const n) noexcept
+    {
+        detail::unmap_pages(p, detail::round_to_pages(n * sizeof(T)));
+    }
+
+  private:
+    /// the used policy
+    numa_policy m_policy{};
+};
+
+/// all numa_allocators can release the memory of each other
+template <typename T, typename U>
+constexpr bool operator==(numa_allocator<T> const&, numa_allocator<U> const&) noexcept
+{
+    return true;
+}
+
+/// all numa_allocators can release the memory of each other
+template <typename T, typename U>
+constexpr bool operator!=(numa_allocator<T> const&, numa_allocator<U> const&) noexcept
+{
+    return false;
+}
+
+
+/// runtime_array placed on NUMA nodes according to a numa_policy
+template <typename T>
+using numa_runtime_array = runtime_array<T, numa_allocator<T>>;
+
+} // namespace bosswestfalen
+
+#endif
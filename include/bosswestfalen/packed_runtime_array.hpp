@@ -0,0 +1,489 @@
+/*!
+ * \file packed_runtime_array.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_PACKED_RUNTIME_ARRAY_HPP_
+#define BOSSWESTFALEN_PACKED_RUNTIME_ARRAY_HPP_
+
+
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace bosswestfalen
+{
+namespace detail
+{
+/// mask of the lowest Bits bits
+template <std::size_t Bits>
+inline constexpr std::uint64_t low_bits = ~std::uint64_t{0} >> (64 - Bits);
+
+/// get the Bits bits starting at bit Offset of words
+template <std::size_t Bits, std::size_t Offset>
+inline auto extract_bits(std::uint64_t const* const words) noexcept -> std::uint64_t
+{
+    constexpr auto w = Offset / 64;
+    constexpr auto shift = Offset % 64;
+    if constexpr (shift + Bits <= 64)
+    {
+        return (words[w] >> shift) & low_bits<Bits>;
+    }
+    else
+    {
+        return ((words[w] >> shift) | (words[w + 1] << (64 - shift))) & low_bits<Bits>;
+    }
+}
+
+/// add the lowest Bits bits of value at bit Offset of words, which must be 0 there
+template <std::size_t Bits, std::size_t Offset>
+inline void deposit_bits(std::uint64_t* const words, std::uint64_t value) noexcept
+{
+    constexpr auto w = Offset / 64;
+    constexpr auto shift = Offset % 64;
+    value &= low_bits<Bits>;
+    words[w] |= value << shift;
+    if constexpr (shift + Bits > 64)
+    {
+        words[w + 1] |= value >> (64 - shift);
+    }
+}
+
+/// unpack the 64 values of the Bits words of a group, all shifts are constants
+template <std::size_t Bits, typename U, std::size_t... J>
+inline void unpack_group(std::uint64_t const* const words, U* const out, std::index_sequence<J...>) noexcept
+{
+    ((out[J] = static_cast<U>(extract_bits<Bits, J * Bits>(words))), ...);
+}
+
+/// pack 64 values into the Bits words of a group, all shifts are constants
+template <std::size_t Bits, typename U, std::size_t... J>
+inline void pack_group(U const* const values, std::uint64_t* const words, std::index_sequence<J...>) noexcept
+{
+    std::fill_n(words, Bits, std::uint64_t{0});
+    (deposit_bits<Bits, J * Bits>(words, static_cast<std::uint64_t>(values[J])), ...);
+}
+} // namespace detail
+
+
+/*!
+ * \brief Fixed size array of unsigned integers of Bits bits each, that can be created at runtime.
+ *
+ * The values are stored back to back in the words of a
+ * runtime_array<std::uint64_t>, a value may span two words. E.g. 20 bit
+ * values need 20/64 of the memory of 64 bit slots, so three times as many
+ * fit into the caches.
+ *
+ * get() and set() are O(1) and branch-free. Bulk unpack() and the packing
+ * ctor work on groups of 64 values, which occupy exactly Bits words, so
+ * all shifts are compile time constants.
+ *
+ * \tparam Bits bits per value, 1 to 64
+ * \tparam Allocator allocator of the words, its value_type must be std::uint64_t
+ *
+ * \note Values are truncated to their lowest Bits bits when stored.
+ */
+template <std::size_t Bits, typename Allocator = std::allocator<std::uint64_t>>
+class packed_runtime_array final
+{
+    static_assert(Bits >= 1 and Bits <= 64, "Bits must be in [1, 64]");
+
+  public:
+    /// type of the words holding the values
+    using word_type = std::uint64_t;
+
+    /// type of the underlying storage
+    using container_type = runtime_array<word_type, Allocator>;
+
+    /// size type
+    using size_type = std::size_t;
+
+    /// type of a value
+    using value_type = std::uint64_t;
+
+    /// alias for Allocator
+    using allocator_type = Allocator;
+
+    /// value of a read-only element
+    using const_reference = value_type;
+
+    /// bits per value
+    static constexpr size_type bits = Bits;
+
+    /// largest value that can be stored
+    static constexpr value_type max_value = detail::low_bits<Bits>;
+
+    /// number of values per group, a group occupies exactly Bits words
+    static constexpr size_type group_size = 64;
+
+    /// proxy reference to a value
+    class reference final
+    {
+      public:
+        /// refer to value pos of array
+        reference(packed_runtime_array& array, size_type const pos) noexcept
+            : m_array{array}
+            , m_pos{pos}
+        {
+        }
+
+        /// copy the referenced value, not the reference
+        reference(reference const&) noexcept = default;
+
+        /// get the value
+        operator value_type() const noexcept
+        {
+            return m_array.get(m_pos);
+        }
+
+        /// set the value
+        auto operator=(value_type const value) noexcept -> reference&
+        {
+            m_array.set(m_pos, value);
+            return *this;
+        }
+
+        /// set the value to the value referenced by rhs
+        auto operator=(reference const& rhs) noexcept -> reference&
+        {
+            return *this = static_cast<value_type>(rhs);
+        }
+
+      private:
+        /// the array
+        packed_runtime_array& m_array;
+
+        /// position of the value
+        size_type m_pos;
+    };
+
+    /// create empty array
+    packed_runtime_array() = default;
+
+    /*!
+     * \brief create with n values, all 0
+     *
+     * \param n number of values
+     * \param alloc allocator to use
+     */
+    explicit packed_runtime_array(size_type const n, allocator_type const& alloc = allocator_type{})
+        : m_words(words_for(n), value_initialise, alloc)
+        , m_size{n}
+    {
+    }
+
+    /*!
+     * \brief create with n values, all equal to value
+     *
+     * \param n number of values
+     * \param value the value
+     * \param alloc allocator to use
+     */
+    packed_runtime_array(size_type const n, value_type const value, allocator_type const& alloc = allocator_type{})
+        : packed_runtime_array(n, alloc)
+    {
+        fill(value);
+    }
+
+    /*!
+     * \brief create with the given values
+     *
+     * \param il the values
+     * \param alloc allocator to use
+     */
+    packed_runtime_array(std::initializer_list<value_type> const il, allocator_type const& alloc = allocator_type{})
+        : packed_runtime_array(il.begin(), il.size(), alloc)
+    {
+    }
+
+    /*!
+     * \brief pack n unsigned integers
+     *
+     * \param values the values, e.g. data() of a runtime_array<std::uint32_t>
+     * \param n number of values
+     * \param alloc allocator to use
+     */
+    template <typename U, typename = std::enable_if_t<std::is_integral_v<U> and std::is_unsigned_v<U>>>
+    packed_runtime_array(U const* const values, size_type const n, allocator_type const& alloc = allocator_type{})
+        : m_words(words_for(n), for_overwrite, alloc)
+        , m_size{n}
+    {
+        auto const words = data();
+        auto const groups = n / group_size;
+        for (auto g = size_type{0}; g < groups; ++g)
+        {
+            detail::pack_group<Bits>(values + g * group_size, words + g * Bits, std::make_index_sequence<group_size>{});
+        }
+        std::fill(words + groups * Bits, words + word_count(), word_type{0});
+        for (auto i = groups * group_size; i < n; ++i)
+        {
+            set(i, values[i]);
+        }
+    }
+
+    /// pack the values of a runtime_array of unsigned integers
+    template <typename U, typename A, typename = std::enable_if_t<std::is_integral_v<U> and std::is_unsigned_v<U>>>
+    explicit packed_runtime_array(runtime_array<U, A> const& values, allocator_type const& alloc = allocator_type{})
+        : packed_runtime_array(values.data(), values.size(), alloc)
+    {
+    }
+
+    /// copy construct
+    packed_runtime_array(packed_runtime_array const&) = default;
+
+    /// move construct, orig will be empty
+    packed_runtime_array(packed_runtime_array&& orig) noexcept
+        : m_words{std::move(orig.m_words)}
+        , m_size{std::exchange(orig.m_size, 0)}
+    {
+    }
+
+    /// copy assign
+    packed_runtime_array& operator=(packed_runtime_array const&) = default;
+
+    /// move assign, rhs will be empty unless its words had to be copied to a different allocator
+    packed_runtime_array& operator=(packed_runtime_array&& rhs) noexcept(std::is_nothrow_move_assignable_v<container_type>)
+    {
+        m_words = std::move(rhs.m_words);
+        m_size = rhs.m_size;
+        if (rhs.m_words.empty())
+        {
+            rhs.m_size = 0;
+        }
+        return *this;
+    }
+
+    /// get the allocator
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type
+    {
+        return m_words.get_allocator();
+    }
+
+    /// check for emptiness
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /// get number of values
+    [[nodiscard]] auto size() const noexcept -> size_type
+    {
+        return m_size;
+    }
+
+    /// get number of words, including one word of padding
+    [[nodiscard]] auto word_count() const noexcept -> size_type
+    {
+        return m_words.size();
+    }
+
+    /// get pointer to the first word
+    [[nodiscard]] auto data() const noexcept -> word_type const*
+    {
+        return m_words.data();
+    }
+
+    /// \copydoc data() const
+    [[nodiscard]] auto data() noexcept -> word_type*
+    {
+        return m_words.data();
+    }
+
+    /// get value at pos, no bounds checking is performed
+    [[nodiscard]] auto get(size_type const pos) const noexcept -> value_type
+    {
+        auto const bit = pos * Bits;
+        auto const w = bit / 64;
+        auto const shift = bit % 64;
+        // the padding word makes words[w + 1] valid; shifting twice avoids a shift by 64
+        auto const high = (m_words[w + 1] << 1) << (63 - shift);
+        return ((m_words[w] >> shift) | high) & max_value;
+    }
+
+    /// set value at pos, no bounds checking is performed
+    void set(size_type const pos, value_type value) noexcept
+    {
+        value &= max_value;
+        auto const bit = pos * Bits;
+        auto const w = bit / 64;
+        auto const shift = bit % 64;
+        m_words[w] = (m_words[w] & ~(max_value << shift)) | (value << shift);
+        auto const high_mask = (max_value >> 1) >> (63 - shift);
+        m_words[w + 1] = (m_words[w + 1] & ~high_mask) | (((value >> 1) >> (63 - shift)) & high_mask);
+    }
+
+    /// get value at pos, no bounds checking is performed
+    [[nodiscard]] auto operator[](size_type const pos) const noexcept -> const_reference
+    {
+        return get(pos);
+    }
+
+    /// \copydoc operator[](size_type) const
+    [[nodiscard]] auto operator[](size_type const pos) noexcept -> reference
+    {
+        return reference{*this, pos};
+    }
+
+    /*!
+     * \brief get value at pos with bounds checking
+     *
+     * \throw std::out_of_range if pos is not less than size()
+     */
+    [[nodiscard]] auto at(size_type const pos) const -> const_reference
+    {
+        if (size() <= pos)
+        {
+            throw std::out_of_range{""};
+        }
+        return get(pos);
+    }
+
+    /// \copydoc at(size_type) const
+    [[nodiscard]] auto at(size_type const pos) -> reference
+    {
+        if (size() <= pos)
+        {
+            throw std::out_of_range{""};
+        }
+        return operator[](pos);
+    }
+
+    /// set all values to value, group by group
+    void fill(value_type const value) noexcept
+    {
+        auto group = std::array<value_type, group_size>{};
+        group.fill(value);
+        auto pattern = std::array<word_type, Bits>{};
+        detail::pack_group<Bits>(group.data(), pattern.data(), std::make_index_sequence<group_size>{});
+
+        auto const groups = size() / group_size;
+        for (auto g = size_type{0}; g < groups; ++g)
+        {
+            std::copy_n(pattern.data(), Bits, data() + g * Bits);
+        }
+        for (auto i = groups * group_size; i < size(); ++i)
+        {
+            set(i, value);
+        }
+    }
+
+    /*!
+     * \brief unpack n values starting at first into out
+     *
+     * Values are truncated to U.
+     */
+    template <typename U>
+    void unpack(size_type const first, size_type const n, U* const out) const noexcept
+    {
+        // values up to the next group boundary, whole groups, rest
+        auto const head = std::min(n, (group_size - first % group_size) % group_size);
+        auto const groups = (n - head) / group_size;
+        for (auto k = size_type{0}; k < head; ++k)
+        {
+            out[k] = static_cast<U>(get(first + k));
+        }
+        auto const group_words = data() + (first + head) / group_size * Bits;
+        for (auto g = size_type{0}; g < groups; ++g)
+        {
+            detail::unpack_group<Bits>(group_words + g * Bits, out + head + g * group_size, std::make_index_sequence<group_size>{});
+        }
+        for (auto k = head + groups * group_size; k < n; ++k)
+        {
+            out[k] = static_cast<U>(get(first + k));
+        }
+    }
+
+    /// unpack all values into a runtime_array<U>
+    template <typename U = value_type>
+    [[nodiscard]] auto unpack() const -> runtime_array<U>
+    {
+        auto result = runtime_array<U>(size(), for_overwrite);
+        unpack(0, size(), result.data());
+        return result;
+    }
+
+    /// get the underlying storage
+    [[nodiscard]] auto container() const noexcept -> container_type const&
+    {
+        return m_words;
+    }
+
+    /// swap with another packed_runtime_array
+    void swap(packed_runtime_array& rhs) noexcept
+    {
+        m_words.swap(rhs.m_words);
+        std::swap(m_size, rhs.m_size);
+    }
+
+  private:
+    /*!
+     * \brief number of words for n values, plus one word of padding
+     *
+     * \throw std::bad_array_new_length if n values do not fit into memory
+     */
+    static auto words_for(size_type const n) -> size_type
+    {
+        if (n == 0)
+        {
+            return 0;
+        }
+        if (n > (std::numeric_limits<size_type>::max() - 128) / Bits)
+        {
+            throw std::bad_array_new_length{};
+        }
+        return (n * Bits + 63) / 64 + 1;
+    }
+
+    /// the words
+    container_type m_words{};
+
+    /// number of values
+    size_type m_size{0};
+};
+
+/// compare whether equal
+template <std::size_t Bits, typename Allocator>
+bool operator==(packed_runtime_array<Bits, Allocator> const& lhs, packed_runtime_array<Bits, Allocator> const& rhs)
+{
+    return lhs.size() == rhs.size() and lhs.container() == rhs.container();
+}
+
+/// compare whether not equal
+template <std::size_t Bits, typename Allocator>
+bool operator!=(packed_runtime_array<Bits, Allocator> const& lhs, packed_runtime_array<Bits, Allocator> const& rhs)
+{
+    return not (lhs == rhs);
+}
+
+/// swap two packed_runtime_arrays
+template <std::size_t Bits, typename Allocator>
+void swap(packed_runtime_array<Bits, Allocator>& lhs, packed_runtime_array<Bits, Allocator>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/// packed_runtime_array is trivially relocatable, if its words are
+template <std::size_t Bits, typename Allocator>
+struct is_trivially_relocatable<packed_runtime_array<Bits, Allocator>>
+    : is_trivially_relocatable<runtime_array<std::uint64_t, Allocator>>
+{
+};
+
+} // namespace bosswestfalen
+
+#endif
@@ -0,0 +1,261 @@
+/*!
+ * \file page_allocator.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_PAGE_ALLOCATOR_HPP_
+#define BOSSWESTFALEN_PAGE_ALLOCATOR_HPP_
+
+
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+#if __has_include(<sys/mman.h>) and __has_include(<unistd.h>)
+#include <sys/mman.h>
+#include <unistd.h>
+#define BOSSWESTFALEN_HAS_PAGES 1
+#else
+#define BOSSWESTFALEN_HAS_PAGES 0
+#endif
+
+
+namespace bosswestfalen
+{
+namespace detail
+{
+/// size of a memory page
+inline auto page_size() noexcept -> std::size_t
+{
+#if BOSSWESTFALEN_HAS_PAGES
+    static auto const size = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+#else
+    return 4096;
+#endif
+}
+
+/// round bytes up to a multiple of page_size()
+inline auto round_to_pages(std::size_t const bytes) noexcept -> std::size_t
+{
+    auto const size = page_size();
+    return (bytes + size - 1) / size * size;
+}
+
+/*!
+ * \brief map fresh anonymous pages
+ *
+ * The operating system hands out zeroed pages and only provides physical
+ * memory for a page when it is touched first.
+ *
+ * \param bytes size, must be a multiple of page_size()
+ * \return zeroed memory aligned to page_size()
+ * \throw std::bad_alloc if no memory is available
+ */
+inline auto map_pages(std::size_t const bytes) -> void*
+{
+#if BOSSWESTFALEN_HAS_PAGES
+    auto const p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+    {
+        throw std::bad_alloc{};
+    }
+    return p;
+#else
+    auto const p = ::operator new(bytes, std::align_val_t{page_size()});
+    std::memset(p, 0, bytes);
+    return p;
+#endif
+}
+
+/// give back memory of map_pages()
+inline void unmap_pages(void* const p, std::size_t const bytes) noexcept
+{
+#if BOSSWESTFALEN_HAS_PAGES
+    ::munmap(p, bytes);
+#else
+    static_cast<void>(bytes);
+    ::operator delete(p, std::align_val_t{page_size()});
+#endif
+}
+
+/*!
+ * \brief resize memory of map_pages()
+ *
+ * The pages are remapped without copying where mremap is available,
+ * otherwise new pages are mapped and the contents are copied.
+ *
+ * \param p memory of map_pages()
+ * \param old_bytes current size, must be a multiple of page_size()
+ * \param new_bytes new size, must be a multiple of page_size()
+ * \return memory holding the first min(old_bytes, new_bytes) bytes of p,
+ *         the remaining bytes are zero
+ * \throw std::bad_alloc if no memory is available, p is unchanged then
+ */
+inline auto remap_pages(void* const p, std::size_t const old_bytes, std::size_t const new_bytes) -> void*
+{
+#if BOSSWESTFALEN_HAS_PAGES and defined(MREMAP_MAYMOVE)
+    auto const q = ::mremap(p, old_bytes, new_bytes, MREMAP_MAYMOVE);
+    if (q == MAP_FAILED)
+    {
+        throw std::bad_alloc{};
+    }
+    return q;
+#else
+    auto const q = map_pages(new_bytes);
+    std::memcpy(q, p, std::min(old_bytes, new_bytes));
+    unmap_pages(p, old_bytes);
+    return q;
+#endif
+}
+} // namespace detail
+
+
+/*!
+ * \brief Stateless allocator mapping large arrays directly from the operating system.
+ *
+ * Requests of at least Threshold bytes are mapped as fresh anonymous pages,
+ * smaller requests use the global operator new.
+ *
+ * Mapped pages are already zero, so allocate_zeroed() needs no pass over the
+ * memory: a value-initialised runtime_array of arithmetic type only gets
+ * physical memory for the pages that are actually touched.
+ *
+ * \tparam T type of allocated elements
+ * \tparam Threshold minimal size in bytes for mapped memory
+ */
+template <typename T, std::size_t Threshold = 128 * 1024>
+class page_allocator final
+{
+  public:
+    /// alias for T
+    using value_type = T;
+
+    /// all instances are equal
+    using is_always_equal = std::true_type;
+
+    /// minimal size in bytes for mapped memory
+    static constexpr std::size_t threshold = Threshold;
+
+    /// rebind to another element type, keeping the threshold
+    template <typename U>
+    struct rebind
+    {
+        /// rebound allocator
+        using other = page_allocator<U, Threshold>;
+    };
+
+    /// default ctor
+    page_allocator() noexcept = default;
+
+    /// rebind
+    template <typename U>
+    page_allocator(page_allocator<U, Threshold> const&) noexcept
+    {
+    }
+
+    /// check whether n elements are placed on mapped pages
+    [[nodiscard]] static constexpr auto uses_pages(std::size_t const n) noexcept -> bool
+    {
+        return n * sizeof(T) >= threshold;
+    }
+
+    /// get memory for n elements
+    [[nodiscard]] auto allocate(std::size_t const n) -> T*
+    {
+        check_size(n);
+        if (uses_pages(n))
+        {
+            return static_cast<T*>(detail::map_pages(detail::round_to_pages(n * sizeof(T))));
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignof(T)}));
+    }
+
+    /// get zeroed memory for n elements, mapped pages are not touched
+    [[nodiscard]] auto allocate_zeroed(std::size_t const n) -> T*
+    {
+        auto const p = allocate(n);
+        if (not uses_pages(n))
+        {
+            std::memset(p, 0, n * sizeof(T));
+        }
+        return p;
+    }
+
+    /*!
+     * \brief resize memory of old_n elements to new_n elements, keeping its bytes
+     *
+     * Mapped pages are remapped, so even huge arrays are not copied.
+     *
+     * \return memory holding the bytes of the first min(old_n, new_n) elements
+     * \throw std::bad_alloc if no memory is available, p is unchanged then
+     */
+    [[nodiscard]] auto reallocate(T* const p, std::size_t const old_n, std::size_t const new_n) -> T*
+    {
+        check_size(new_n);
+        if (uses_pages(old_n) and uses_pages(new_n))
+        {
+            auto const old_bytes = detail::round_to_pages(old_n * sizeof(T));
+            auto const new_bytes = detail::round_to_pages(new_n * sizeof(T));
+            return (old_bytes == new_bytes) ? p : static_cast<T*>(detail::remap_pages(p, old_bytes, new_bytes));
+        }
+
+        auto const q = allocate(new_n);
+        std::memcpy(q, p, std::min(old_n, new_n) * sizeof(T));
+        deallocate(p, old_n);
+        return q;
+    }
+
+    /// give back memory of n elements
+    void deallocate(T* const p, std::size_t const n) noexcept
+    {
+        if (uses_pages(n))
+        {
+            detail::unmap_pages(p, detail::round_to_pages(n * sizeof(T)));
+            return;
+        }
+        ::operator delete(p, std::align_val_t{alignof(T)});
+    }
+
+  private:
+    /// throw if n elements do not fit into the address space
+    static void check_size(std::size_t const n)
+    {
+        if (n > (std::numeric_limits<std::size_t>::max() - detail::page_size()) / sizeof(T))
+        {
+            throw std::bad_array_new_length{};
+        }
+    }
+};
+
+/// all page_allocators are equal
+template <typename T, typename U, std::size_t S>
+constexpr bool operator==(page_allocator<T, S> const&, page_allocator<U, S> const&) noexcept
+{
+    return true;
+}
+
+/// all page_allocators are equal
+template <typename T, typename U, std::size_t S>
+constexpr bool operator!=(page_allocator<T, S> const&, page_allocator<U, S> const&) noexcept
+{
+    return false;
+}
+
+
+/// runtime_array whose large instances are placed on freshly mapped pages
+template <typename T, std::size_t Threshold = 128 * 1024>
+using page_runtime_array = runtime_array<T, page_allocator<T, Threshold>>;
+
+} // namespace bosswestfalen
+
+#endif
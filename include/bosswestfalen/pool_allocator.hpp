@@ -0,0 +1,617 @@
+/*!
+ * \file pool_allocator.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_POOL_ALLOCATOR_HPP_
+#define BOSSWESTFALEN_POOL_ALLOCATOR_HPP_
+
+
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace bosswestfalen
+{
+/// hit and miss counters of one size class of the slab_pool
+struct pool_statistics
+{
+    /// size of the blocks in bytes
+    std::size_t block_size{0};
+
+    /// allocations served by the cache of the calling thread
+    std::uint64_t hits{0};
+
+    /// allocations that had to refill the cache from the depot or a new slab
+    std::uint64_t misses{0};
+};
+
+
+/*!
+ * \brief Process wide pool of small memory blocks, sorted by size class.
+ *
+ * Requests are rounded up to a power of two between min_block_size and
+ * max_block_size. Each thread keeps a free list per size class, so the common
+ * case needs neither locks nor atomics. Surplus blocks of a thread, and all
+ * blocks of exiting threads, are moved in batches of batch_size blocks to a
+ * shared depot from which other threads refill. The depot is a lock-free
+ * stack of batches; a refill or spill moves exactly one batch in O(1) with a
+ * single compare-and-swap, no list is ever walked. Its head carries a
+ * generation tag, so a batch that was popped and pushed again in between
+ * cannot be mistaken for the old head. Blocks may be freed by any thread.
+ *
+ * Memory is taken from the system in slabs and only given back when the
+ * program ends.
+ */
+class slab_pool final
+{
+  public:
+    /// size type
+    using size_type = std::size_t;
+
+    /// smallest size class in bytes
+    static constexpr size_type min_block_size = 16;
+
+    /// largest size class in bytes, larger requests are not served by the pool
+    static constexpr size_type max_block_size = 4096;
+
+    /// number of size classes
+    static constexpr size_type class_count = 9;
+
+    /// largest alignment the blocks can guarantee
+    static constexpr size_type max_alignment = alignof(std::max_align_t);
+
+    /// bytes requested from the system at once
+    static constexpr size_type slab_size = 64 * 1024;
+
+    /// number of blocks a thread keeps per size class before moving blocks to the depot
+    static constexpr size_type cache_limit = 64;
+
+    /// number of blocks moved between a thread and the depot at once
+    static constexpr size_type batch_size = cache_limit / 2;
+
+    static_assert((min_block_size << (class_count - 1)) == max_block_size);
+
+    /// access the pool
+    static auto instance() -> slab_pool&
+    {
+        static auto pool = slab_pool{};
+        return pool;
+    }
+
+    /// the pool is not copyable
+    slab_pool(slab_pool const&) = delete;
+
+    /// the pool is not movable
+    slab_pool(slab_pool&&) = delete;
+
+    /// the pool is not copyable
+    slab_pool& operator=(slab_pool const&) = delete;
+
+    /// the pool is not movable
+    slab_pool& operator=(slab_pool&&) = delete;
+
+    /// give all slabs back to the system
+    ~slab_pool()
+    {
+        auto header = m_slabs.load(std::memory_order_acquire);
+        while (header not_eq nullptr)
+        {
+            auto const next = header->next;
+            ::operator delete(header);
+            header = next;
+        }
+    }
+
+    /// check whether a request can be served by the pool
+    [[nodiscard]] static constexpr auto is_pooled(size_type const bytes, size_type const alignment) noexcept -> bool
+    {
+        return bytes <= max_block_size and alignment <= max_alignment;
+    }
+
+    /// index of the size class for bytes
+    [[nodiscard]] static constexpr auto size_class(size_type const bytes) noexcept -> size_type
+    {
+        auto index = size_type{0};
+        for (auto size = min_block_size; size < bytes; size *= 2)
+        {
+            ++index;
+        }
+        return index;
+    }
+
+    /*!
+     * \brief get a block
+     *
+     * \param bytes requested size, must not exceed max_block_size
+     * \return block of at least bytes bytes
+     */
+    [[nodiscard]] auto allocate(size_type const bytes) -> void*
+    {
+        auto const index = size_class(bytes);
+        auto const cache = local_cache();
+        if (cache == nullptr)
+        {
+            return take_from_depot(index);
+        }
+
+        auto& bin = cache->bins[index];
+        if (bin.head == nullptr and bin.spare not_eq nullptr)
+        {
+            bin.head = std::exchange(bin.spare, nullptr);
+            bin.count = batch_size;
+        }
+        if (bin.head not_eq nullptr)
+        {
+            ++bin.hits;
+            auto const block = bin.head;
+            bin.head = block->next;
+            --bin.count;
+            return block;
+        }
+
+        return refill(bin, index);
+    }
+
+    /*!
+     * \brief give a block back
+     *
+     * \param p block obtained by allocate()
+     * \param bytes size passed to allocate()
+     */
+    void deallocate(void* const p, size_type const bytes) noexcept
+    {
+        auto const index = size_class(bytes);
+        auto const block = ::new (p) free_block{};
+        auto const cache = local_cache();
+        if (cache == nullptr)
+        {
+            push_batch(index, block, 1);
+            return;
+        }
+
+        auto& bin = cache->bins[index];
+        block->next = bin.head;
+        bin.head = block;
+        if (++bin.count == batch_size)
+        {
+            spill(bin, index);
+        }
+    }
+
+    /*!
+     * \brief get hit and miss counters of all size classes
+     *
+     * Counters of the calling thread are up to date, other threads publish
+     * their hits on every miss and when they end.
+     */
+    [[nodiscard]] auto statistics() -> std::array<pool_statistics, class_count>
+    {
+        if (auto const cache = local_cache(); cache not_eq nullptr)
+        {
+            publish(*cache);
+        }
+
+        auto result = std::array<pool_statistics, class_count>{};
+        for (auto i = size_type{0}; i < class_count; ++i)
+        {
+            result[i].block_size = min_block_size << i;
+            result[i].hits = m_classes[i].hits.load(std::memory_order_relaxed);
+            result[i].misses = m_classes[i].misses.load(std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+  private:
+    /*!
+     * \brief unused block, linked to the next one
+     *
+     * The first block of a batch in the depot links to the next batch, the
+     * second one stores the number of blocks of the batch. A batch of a
+     * single block has no second block.
+     */
+    struct free_block
+    {
+        /// next unused block of the same list or batch
+        free_block* next{nullptr};
+
+        union
+        {
+            /// first block of a batch: first block of the next batch in the depot
+            free_block* next_batch;
+
+            /// second block of a batch: number of blocks in the batch
+            size_type count;
+        };
+    };
+
+    static_assert(sizeof(free_block) <= min_block_size);
+
+    /// header at the beginning of each slab
+    struct slab_header
+    {
+        /// slab allocated before
+        slab_header* next;
+    };
+
+    /// first batch of a depot in the low address_bits bits, generation tag in the bits above
+    using tagged_batch = std::uint64_t;
+
+    /// bits of a block address, user space addresses of 64-bit platforms fit into 48 bits
+    static constexpr unsigned address_bits = (sizeof(void*) < sizeof(tagged_batch)) ? 32 : 48;
+
+    /// mask of the address bits of a tagged_batch
+    static constexpr tagged_batch address_mask = (tagged_batch{1} << address_bits) - 1;
+
+    static_assert(std::atomic<tagged_batch>::is_always_lock_free);
+
+    /// shared state of one size class
+    struct size_class_state
+    {
+        /// stack of batches of unused blocks
+        std::atomic<tagged_batch> depot{0};
+
+        /// published hits
+        std::atomic<std::uint64_t> hits{0};
+
+        /// published misses
+        std::atomic<std::uint64_t> misses{0};
+    };
+
+    /// per thread state
+    struct thread_cache
+    {
+        /// free list of one size class
+        struct bin
+        {
+            /// first unused block
+            free_block* head{nullptr};
+
+            /// number of blocks in the list at head, less than batch_size
+            size_type count{0};
+
+            /// a full batch of batch_size blocks, or nullptr
+            free_block* spare{nullptr};
+
+            /// hits not yet published
+            std::uint64_t hits{0};
+        };
+
+        /// create cache of pool
+        explicit thread_cache(slab_pool& p) noexcept
+            : pool{p}
+        {
+        }
+
+        /// move all blocks to the depot, so other threads can use them
+        ~thread_cache()
+        {
+            pool.publish(*this);
+            for (auto i = size_type{0}; i < class_count; ++i)
+            {
+                auto& b = bins[i];
+                if (b.head not_eq nullptr)
+                {
+                    pool.push_batch(i, b.head, b.count);
+                }
+                if (b.spare not_eq nullptr)
+                {
+                    pool.push_batch(i, b.spare, batch_size);
+                }
+            }
+            cache_state() = state::destroyed;
+        }
+
+        /// caches are bound to their thread
+        thread_cache(thread_cache const&) = delete;
+
+        /// caches are bound to their thread
+        thread_cache& operator=(thread_cache const&) = delete;
+
+        /// the pool
+        slab_pool& pool;
+
+        /// free lists of all size classes
+        std::array<bin, class_count> bins{};
+    };
+
+    /// life cycle of the cache of a thread
+    enum class state
+    {
+        unused,
+        alive,
+        destroyed
+    };
+
+    /// only instance() creates the pool
+    slab_pool() = default;
+
+    /*!
+     * \brief state of the cache of the calling thread
+     *
+     * Trivially destructible, so it can still be read after the cache is gone.
+     */
+    static auto cache_state() noexcept -> state&
+    {
+        thread_local auto s = state::unused;
+        return s;
+    }
+
+    /// cache of the calling thread, nullptr while the thread shuts down
+    auto local_cache() noexcept -> thread_cache*
+    {
+        if (cache_state() == state::destroyed)
+        {
+            return nullptr;
+        }
+
+        thread_local auto cache = thread_cache{*this};
+        cache_state() = state::alive;
+        return &cache;
+    }
+
+    /// add hits of cache to the shared counters
+    void publish(thread_cache& cache) noexcept
+    {
+        for (auto i = size_type{0}; i < class_count; ++i)
+        {
+            if (cache.bins[i].hits not_eq 0)
+            {
+                m_classes[i].hits.fetch_add(cache.bins[i].hits, std::memory_order_relaxed);
+                cache.bins[i].hits = 0;
+            }
+        }
+    }
+
+    /// first batch of head
+    static auto batch_of(tagged_batch const head) noexcept -> free_block*
+    {
+        return reinterpret_cast<free_block*>(static_cast<std::uintptr_t>(head & address_mask));
+    }
+
+    /// head for first, with a generation tag following the one of old
+    static auto successor(tagged_batch const old, free_block* const first) noexcept -> tagged_batch
+    {
+        return ((old | address_mask) + 1) | static_cast<tagged_batch>(reinterpret_cast<std::uintptr_t>(first));
+    }
+
+    /// push the batch of count linked blocks starting at first to the depot
+    void push_batch(size_type const index, free_block* const first, size_type const count) noexcept
+    {
+        if (count > 1)
+        {
+            first->next->count = count;
+        }
+
+        auto& depot = m_classes[index].depot;
+        auto head = depot.load(std::memory_order_relaxed);
+        do
+        {
+            first->next_batch = batch_of(head);
+        } while (not depot.compare_exchange_weak(head, successor(head, first), std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    /*!
+     * \brief pop one batch from the depot
+     *
+     * \param count set to the number of blocks of the batch
+     * \return first block of the batch, nullptr if the depot is empty
+     */
+    auto pop_batch(size_type const index, size_type& count) noexcept -> free_block*
+    {
+        auto& depot = m_classes[index].depot;
+        auto head = depot.load(std::memory_order_acquire);
+        auto first = batch_of(head);
+        // first may be popped and reused meanwhile, slabs are never unmapped and the tag then fails the exchange
+        while (first not_eq nullptr
+               and not depot.compare_exchange_weak(head, successor(head, first->next_batch), std::memory_order_acquire,
+                                                   std::memory_order_acquire))
+        {
+            first = batch_of(head);
+        }
+
+        if (first not_eq nullptr)
+        {
+            count = (first->next == nullptr) ? 1 : first->next->count;
+        }
+        return first;
+    }
+
+    /// get one batch from the depot, or a new slab if the depot is empty
+    auto take_batch(size_type const index, size_type& count) -> free_block*
+    {
+        auto const first = pop_batch(index, count);
+        return (first not_eq nullptr) ? first : carve_slab(index, count);
+    }
+
+    /// get a single block without a thread cache, the rest of the batch goes back to the depot
+    auto take_from_depot(size_type const index) -> void*
+    {
+        m_classes[index].misses.fetch_add(1, std::memory_order_relaxed);
+        auto count = size_type{0};
+        auto const first = take_batch(index, count);
+        if (first->next not_eq nullptr)
+        {
+            push_batch(index, first->next, count - 1);
+        }
+        return first;
+    }
+
+    /// fill the empty bin with one batch from the depot or a new slab and return one block
+    auto refill(thread_cache::bin& bin, size_type const index) -> void*
+    {
+        auto& shared = m_classes[index];
+        shared.misses.fetch_add(1, std::memory_order_relaxed);
+        shared.hits.fetch_add(bin.hits, std::memory_order_relaxed);
+        bin.hits = 0;
+
+        auto count = size_type{0};
+        auto const first = take_batch(index, count);
+        bin.head = first->next;
+        bin.count = count - 1;
+        return first;
+    }
+
+    /*!
+     * \brief move the full list of bin to its spare batch
+     *
+     * If there already is a spare batch, that one goes to the depot. The
+     * blocks freed most recently stay with the thread.
+     */
+    void spill(thread_cache::bin& bin, size_type const index) noexcept
+    {
+        if (bin.spare not_eq nullptr)
+        {
+            push_batch(index, bin.spare, batch_size);
+        }
+        bin.spare = std::exchange(bin.head, nullptr);
+        bin.count = 0;
+    }
+
+    /*!
+     * \brief get a new slab and split it into batches of blocks of size class index
+     *
+     * All batches but the first are pushed to the depot.
+     *
+     * \param count set to the number of blocks of the first batch
+     * \return first block of the first batch
+     */
+    auto carve_slab(size_type const index, size_type& count) -> free_block*
+    {
+        auto const memory = static_cast<std::byte*>(::operator new(slab_size));
+        if (((static_cast<tagged_batch>(reinterpret_cast<std::uintptr_t>(memory)) + slab_size - 1) & ~address_mask) not_eq 0)
+        {
+            // blocks of this slab cannot be stored in a depot head
+            ::operator delete(memory);
+            throw std::bad_alloc{};
+        }
+        auto const header = ::new (memory) slab_header{m_slabs.load(std::memory_order_relaxed)};
+        while (not m_slabs.compare_exchange_weak(header->next, header, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+
+        // the first block is reserved for the header to keep all blocks aligned
+        auto const block_size = min_block_size << index;
+        auto const blocks = slab_size / block_size - 1;
+        count = std::min(blocks, batch_size);
+        for (auto first = count; first < blocks; first += batch_size)
+        {
+            auto const n = std::min(blocks - first, batch_size);
+            push_batch(index, link(memory, block_size, first + 1, n), n);
+        }
+        return link(memory, block_size, 1, count);
+    }
+
+    /// link n blocks of block_size bytes starting with block first of memory
+    static auto link(std::byte* const memory, size_type const block_size, size_type const first, size_type const n) noexcept
+        -> free_block*
+    {
+        auto head = static_cast<free_block*>(nullptr);
+        for (auto i = first + n; i > first; --i)
+        {
+            auto const block = ::new (memory + (i - 1) * block_size) free_block{};
+            block->next = head;
+            head = block;
+        }
+        return head;
+    }
+
+    /// all slabs
+    std::atomic<slab_header*> m_slabs{nullptr};
+
+    /// shared state of the size classes
+    std::array<size_class_state, class_count> m_classes{};
+};
+
+
+/*!
+ * \brief Stateless allocator using the slab_pool.
+ *
+ * Requests that are too large or over-aligned for the pool are forwarded
+ * to the global operator new.
+ *
+ * \tparam T type of allocated elements
+ */
+template <typename T>
+class pool_allocator final
+{
+  public:
+    /// alias for T
+    using value_type = T;
+
+    /// all instances share the pool
+    using is_always_equal = std::true_type;
+
+    /// default ctor
+    pool_allocator() noexcept = default;
+
+    /// rebind
+    template <typename U>
+    pool_allocator(pool_allocator<U> const&) noexcept
+    {
+    }
+
+    /// get memory for n elements
+    [[nodiscard]] auto allocate(std::size_t const n) -> T*
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length{};
+        }
+
+        auto const bytes = n * sizeof(T);
+        if (slab_pool::is_pooled(bytes, alignof(T)))
+        {
+            return static_cast<T*>(slab_pool::instance().allocate(bytes));
+        }
+        return static_cast<T*>(::operator new(bytes, std::align_val_t{alignof(T)}));
+    }
+
+    /// give back memory of n elements
+    void deallocate(T* const p, std::size_t const n) noexcept
+    {
+        auto const bytes = n * sizeof(T);
+        if (slab_pool::is_pooled(bytes, alignof(T)))
+        {
+            slab_pool::instance().deallocate(p, bytes);
+            return;
+        }
+        ::operator delete(p, std::align_val_t{alignof(T)});
+    }
+};
+
+/// all pool_allocators are equal
+template <typename T, typename U>
+constexpr bool operator==(pool_allocator<T> const&, pool_allocator<U> const&) noexcept
+{
+    return true;
+}
+
+/// all pool_allocators are equal
+template <typename T, typename U>
+constexpr bool operator!=(pool_allocator<T> const&, pool_allocator<U> const&) noexcept
+{
+    return false;
+}
+
+
+/// runtime_array whose memory is taken from the slab_pool
+template <typename T>
+using pool_runtime_array = runtime_array<T, pool_allocator<T>>;
+
+} // namespace bosswestfalen
+
+#endif
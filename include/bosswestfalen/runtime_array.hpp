@@ -13,12 +13,24 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <exception>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
 #include <stdexcept>
+#include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+
+#if defined(__cpp_impl_three_way_comparison) and __has_include(<compare>)
+#include <compare>
+#endif
 
 
 /*!
@@ -27,16 +39,627 @@
  */
 namespace bosswestfalen
 {
+namespace detail
+{
+/// check whether A has a member construct(Args...)
+template <typename Void, typename A, typename... Args>
+struct has_construct_impl : std::false_type
+{
+};
+
+/// \copydoc has_construct_impl
+template <typename A, typename... Args>
+struct has_construct_impl<std::void_t<decltype(std::declval<A&>().construct(std::declval<Args>()...))>, A, Args...>
+    : std::true_type
+{
+};
+
+/// check whether A has a member destroy(Args...)
+template <typename Void, typename A, typename... Args>
+struct has_destroy_impl : std::false_type
+{
+};
+
+/// \copydoc has_destroy_impl
+template <typename A, typename... Args>
+struct has_destroy_impl<std::void_t<decltype(std::declval<A&>().destroy(std::declval<Args>()...))>, A, Args...>
+    : std::true_type
+{
+};
+
+/// check whether A is a std::allocator
+template <typename A>
+struct is_std_allocator : std::false_type
+{
+};
+
+/// \copydoc is_std_allocator
+template <typename U>
+struct is_std_allocator<std::allocator<U>> : std::true_type
+{
+};
+
 /*!
- * \brief Fixed size array, that can be created at runtime.
+ * \brief true if a default constructed element has to be created via A::construct
  *
- * \tparam T Type of stored elements.
+ * std::allocator is excluded on purpose: its (deprecated) construct member would
+ * value-initialise elements, whereas runtime_array default-initialises them.
+ */
+template <typename A, typename T>
+inline constexpr bool has_default_construct = has_construct_impl<void, A, T*>::value and not is_std_allocator<A>::value;
+
+/// alignment guaranteed by A, if it is larger than alignof(value_type)
+template <typename A, typename = void>
+struct allocator_alignment : std::integral_constant<std::size_t, alignof(typename A::value_type)>
+{
+};
+
+/// \copydoc allocator_alignment
+template <typename A>
+struct allocator_alignment<A, std::void_t<decltype(A::alignment)>>
+    : std::integral_constant<std::size_t, std::max(A::alignment, alignof(typename A::value_type))>
+{
+};
+
+/// check whether A has a member allocate_zeroed(n) returning zeroed memory
+template <typename A, typename = void>
+struct has_allocate_zeroed : std::false_type
+{
+};
+
+/// \copydoc has_allocate_zeroed
+template <typename A>
+struct has_allocate_zeroed<A, std::void_t<decltype(std::declval<A&>().allocate_zeroed(std::size_t{}))>>
+    : std::true_type
+{
+};
+
+/// true if all bits zero is the value-initialised state of T
+template <typename T>
+inline constexpr bool is_zero_initialisable = std::is_scalar_v<T> and not std::is_member_pointer_v<T>;
+
+/// check whether A has a member reallocate(p, old_n, new_n) resizing memory
+template <typename A, typename = void>
+struct has_reallocate : std::false_type
+{
+};
+
+/// \copydoc has_reallocate
+template <typename A>
+struct has_reallocate<A, std::void_t<decltype(std::declval<A&>().reallocate(std::declval<typename A::value_type*>(),
+                                                                              std::size_t{}, std::size_t{}))>>
+    : std::true_type
+{
+};
+
+/// true if I is an iterator of category Tag or a category derived from it
+template <typename I, typename Tag, typename = void>
+struct is_iterator_of : std::false_type
+{
+};
+
+/// \copydoc is_iterator_of
+template <typename I, typename Tag>
+struct is_iterator_of<I, Tag, std::void_t<typename std::iterator_traits<I>::iterator_category>>
+    : std::is_base_of<Tag, typename std::iterator_traits<I>::iterator_category>
+{
+};
+
+#if defined(__cpp_lib_ranges)
+/// true if the number of elements of R is known without traversing it
+template <typename R>
+inline constexpr bool is_sized_range = std::ranges::sized_range<R>;
+
+/// number of elements of a sized range
+template <typename R>
+auto range_size(R& range)
+{
+    return std::ranges::size(range);
+}
+#else
+/// check whether std::size(R&) is valid
+template <typename R, typename = void>
+struct has_size : std::false_type
+{
+};
+
+/// \copydoc has_size
+template <typename R>
+struct has_size<R, std::void_t<decltype(std::size(std::declval<R&>()))>> : std::true_type
+{
+};
+
+/// true if the number of elements of R is known without traversing it
+template <typename R>
+inline constexpr bool is_sized_range = has_size<R>::value;
+
+/// number of elements of a sized range
+template <typename R>
+auto range_size(R& range)
+{
+    return std::size(range);
+}
+#endif
+
+/// true if destroying an element has to be done via A::destroy
+template <typename A, typename T>
+inline constexpr bool has_destroy = has_destroy_impl<void, A, T*>::value and not is_std_allocator<A>::value;
+
+/*!
+ * \brief stores an allocator
+ *
+ * Empty allocators are stored as base class, so they do not need any space (EBO).
+ */
+template <typename A, bool = std::is_empty_v<A> and not std::is_final_v<A>>
+class allocator_holder : private A
+{
+  public:
+    /// default construct allocator
+    allocator_holder() = default;
+
+    /// copy allocator
+    explicit allocator_holder(A const& alloc) noexcept
+        : A(alloc)
+    {
+    }
+
+    /// move allocator
+    explicit allocator_holder(A&& alloc) noexcept
+        : A(std::move(alloc))
+    {
+    }
+
+    /// access to the stored allocator
+    [[nodiscard]] auto allocator() noexcept -> A&
+    {
+        return *this;
+    }
+
+    /// \copydoc allocator()
+    [[nodiscard]] auto allocator() const noexcept -> A const&
+    {
+        return *this;
+    }
+};
+
+/// \copydoc allocator_holder
+template <typename A>
+class allocator_holder<A, false>
+{
+  public:
+    /// default construct allocator
+    allocator_holder() = default;
+
+    /// copy allocator
+    explicit allocator_holder(A const& alloc) noexcept
+        : m_allocator(alloc)
+    {
+    }
+
+    /// move allocator
+    explicit allocator_holder(A&& alloc) noexcept
+        : m_allocator(std::move(alloc))
+    {
+    }
+
+    /// access to the stored allocator
+    [[nodiscard]] auto allocator() noexcept -> A&
+    {
+        return m_allocator;
+    }
+
+    /// \copydoc allocator()
+    [[nodiscard]] auto allocator() const noexcept -> A const&
+    {
+        return m_allocator;
+    }
+
+  private:
+    /// the allocator
+    A m_allocator{};
+};
+} // namespace detail
+
+
+/// tag type to create elements that are overwritten before they are read
+struct for_overwrite_t
+{
+    /// explicit, so {} is not a for_overwrite_t
+    explicit for_overwrite_t() = default;
+};
+
+/*!
+ * \brief tag to create elements that are overwritten before they are read
+ *
+ * Trivially default constructible elements are left uninitialised, without
+ * any per-element work. Other elements are default-initialised.
+ */
+inline constexpr for_overwrite_t for_overwrite{};
+
+/// tag type to value-initialise elements
+struct value_initialise_t
+{
+    /// explicit, so {} is not a value_initialise_t
+    explicit value_initialise_t() = default;
+};
+
+/*!
+ * \brief tag to value-initialise elements
+ *
+ * Arithmetic types, enums and pointers are zeroed.
+ */
+inline constexpr value_initialise_t value_initialise{};
+
+/// tag type to create each element from its index
+struct generate_t
+{
+    /// explicit, so {} is not a generate_t
+    explicit generate_t() = default;
+};
+
+/*!
+ * \brief tag to create each element from its index
+ *
+ * Element i is constructed in place from the result of f(i).
+ */
+inline constexpr generate_t generate{};
+
+/// tag type to create elements from a range
+struct from_range_t
+{
+    /// explicit, so {} is not a from_range_t
+    explicit from_range_t() = default;
+};
+
+/*!
+ * \brief tag to create elements from a range
+ *
+ * Ranges that know their size are copied in a single pass without counting
+ * them first.
+ */
+inline constexpr from_range_t from_range{};
+
+
+/*!
+ * \brief tag to split the work on elements across several threads
+ *
+ * Arrays smaller than threshold bytes are handled by the calling thread only.
+ * Elements are constructed, assigned and destroyed concurrently, so the
+ * allocator's construct() and destroy() have to be thread-safe.
+ */
+struct parallel_t
+{
+    /// default for threshold
+    static constexpr std::size_t default_threshold = 1024 * 1024;
+
+    /// number of threads, 0 uses std::thread::hardware_concurrency()
+    unsigned threads{0};
+
+    /// minimal size in bytes to use more than one thread
+    std::size_t threshold{default_threshold};
+
+    /*!
+     * \brief number of chunks for n elements of element_size bytes
+     *
+     * \return number of threads to use, at least 1 and at most n
+     */
+    [[nodiscard]] auto chunks(std::size_t const n, std::size_t const element_size) const noexcept -> std::size_t
+    {
+        if (n * element_size < threshold)
+        {
+            return 1;
+        }
+
+        auto const available = (threads not_eq 0) ? threads : std::thread::hardware_concurrency();
+        return std::max<std::size_t>(1, std::min<std::size_t>(available, n));
+    }
+};
+
+/// tag to split the work on elements across all hardware threads
+inline constexpr parallel_t parallel{};
+
+
+namespace detail
+{
+/// first index of chunk c, if n elements are split into chunks
+constexpr auto chunk_begin(std::size_t const n, std::size_t const chunks, std::size_t const c) noexcept -> std::size_t
+{
+    return n / chunks * c + std::min(c, n % chunks);
+}
+
+/*!
+ * \brief call body(c, begin, end) for each chunk c of [0, n)
+ *
+ * Chunk 0 is handled by the calling thread, every other chunk by its own
+ * thread. If a thread cannot be started, for any reason including a failed
+ * allocation, its chunk is handled by the calling thread. The first exception thrown by body is rethrown after all chunks
+ * are finished.
+ */
+template <typename Body>
+void parallel_chunks(std::size_t const n, std::size_t const chunks, Body&& body)
+{
+    if (chunks == 1)
+    {
+        body(std::size_t{0}, std::size_t{0}, n);
+        return;
+    }
+
+    auto errors = std::vector<std::exception_ptr>(chunks);
+    auto const run = [n, chunks, &body, &errors](std::size_t const c)
+    {
+        try
+        {
+            body(c, chunk_begin(n, chunks, c), chunk_begin(n, chunks, c + 1));
+        }
+        catch (...)
+        {
+            errors[c] = std::current_exception();
+        }
+    };
+
+    auto workers = std::vector<std::thread>{};
+    workers.reserve(chunks - 1);
+    for (auto c = std::size_t{1}; c < chunks; ++c)
+    {
+        try
+        {
+            workers.emplace_back(run, c);
+        }
+        catch (...)
+        {
+            // std::system_error or std::bad_alloc for the thread state
+            run(c);
+        }
+    }
+    run(0);
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    for (auto const& error : errors)
+    {
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+/// true if two T are equal exactly if their bytes are equal
+template <typename T>
+inline constexpr bool is_bytewise_equal = std::is_scalar_v<T> and not std::is_member_pointer_v<T>
+                                          and std::has_unique_object_representations_v<T>;
+
+/// true if the order of T is the order of its bytes as given by memcmp
+template <typename T>
+inline constexpr bool is_bytewise_ordered = std::is_same_v<T, unsigned char> or std::is_same_v<T, std::byte>
+                                            or (std::is_same_v<T, char> and std::is_unsigned_v<char>);
+
+/*!
+ * \brief index of the first i in [0, n) with differ(a[i], b[i]), n if there is none
+ *
+ * The elements are checked in blocks without early exit inside a block, so
+ * the compiler can vectorise the check. Only the block containing the first
+ * difference is scanned element by element.
+ */
+template <typename T, typename Differ>
+auto mismatch_blocks(T const* const a, T const* const b, std::size_t const n, Differ differ) noexcept -> std::size_t
+{
+    constexpr auto block = std::max<std::size_t>(1, 256 / sizeof(T));
+
+    auto i = std::size_t{0};
+    for (; i + block <= n; i += block)
+    {
+        // counting vectorises better than or-ing bools
+        auto differences = std::size_t{0};
+        for (auto j = std::size_t{0}; j < block; ++j)
+        {
+            differences += differ(a[i + j], b[i + j]) ? 1 : 0;
+        }
+        if (differences not_eq 0)
+        {
+            break;
+        }
+    }
+
+    for (; i < n; ++i)
+    {
+        if (differ(a[i], b[i]))
+        {
+            return i;
+        }
+    }
+    return n;
+}
+
+/*!
+ * \brief index of the first element of a and b that is not equal, n if there is none
+ *
+ * Bytewise equal types are compared blockwise with memcmp, other arithmetic
+ * types with mismatch_blocks() and all others with std::mismatch.
+ */
+template <typename T>
+auto first_mismatch(T const* const a, T const* const b, std::size_t const n) -> std::size_t
+{
+    if constexpr (is_bytewise_equal<T>)
+    {
+        constexpr auto block = std::max<std::size_t>(1, 256 / sizeof(T));
+
+        auto i = std::size_t{0};
+        while (i + block <= n and std::memcmp(a + i, b + i, block * sizeof(T)) == 0)
+        {
+            i += block;
+        }
+        for (; i < n; ++i)
+        {
+            if (a[i] not_eq b[i])
+            {
+                return i;
+            }
+        }
+        return n;
+    }
+    else if constexpr (std::is_arithmetic_v<T>)
+    {
+        return mismatch_blocks(a, b, n, [](T const& x, T const& y) noexcept { return not (x == y); });
+    }
+    else
+    {
+        return static_cast<std::size_t>(std::mismatch(a, a + n, b).first - a);
+    }
+}
+
+/*!
+ * \brief index of the first arithmetic element of a and b that is not equivalent, n if there is none
+ *
+ * Elements are equivalent if neither is less than the other, as in
+ * std::lexicographical_compare. This differs from equality only for NaN.
+ */
+template <typename T>
+auto first_inequivalent(T const* const a, T const* const b, std::size_t const n) noexcept -> std::size_t
+{
+    static_assert(std::is_arithmetic_v<T>);
+
+    auto i = first_mismatch(a, b, n);
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        // skip unequal, but equivalent elements, i.e. NaN
+        while (i not_eq n and not (a[i] < b[i]) and not (b[i] < a[i]))
+        {
+            ++i;
+            i += first_mismatch(a + i, b + i, n - i);
+        }
+    }
+    return i;
+}
+
+/*!
+ * \brief three-way lexicographical comparison of [a, a + na) and [b, b + nb)
+ *
+ * Each pair of elements is visited at most once. Unsigned bytes are compared
+ * with memcmp, other arithmetic types search the first difference with a
+ * vectorisable loop. All other types only need operator<.
+ *
+ * \return -1 if a is less than b, 1 if a is greater than b, 0 otherwise
+ */
+template <typename T>
+auto lexicographical_order(T const* const a, std::size_t const na, T const* const b, std::size_t const nb) -> int
+{
+    auto const n = std::min(na, nb);
+    auto const order_of_sizes = (na < nb) ? -1 : ((nb < na) ? 1 : 0);
+    if (n == 0)
+    {
+        return order_of_sizes;
+    }
+
+    if constexpr (is_bytewise_ordered<T>)
+    {
+        auto const order = std::memcmp(a, b, n);
+        return (order < 0) ? -1 : ((order > 0) ? 1 : order_of_sizes);
+    }
+    else if constexpr (std::is_arithmetic_v<T>)
+    {
+        auto const i = first_inequivalent(a, b, n);
+        return (i == n) ? order_of_sizes : ((a[i] < b[i]) ? -1 : 1);
+    }
+    else
+    {
+        for (auto i = std::size_t{0}; i < n; ++i)
+        {
+            if (a[i] < b[i])
+            {
+                return -1;
+            }
+            if (b[i] < a[i])
+            {
+                return 1;
+            }
+        }
+        return order_of_sizes;
+    }
+}
+} // namespace detail
+
+
+/*!
+ * \brief check whether T can be relocated by copying its bytes
+ *
+ * Relocation moves an object to new memory and ends the lifetime of the old
+ * object. For trivially relocatable types this is a plain memcpy, the source
+ * is neither moved from nor destroyed.
+ *
+ * Trivially copyable types are trivially relocatable. Other types opt in by
+ * specialising this trait.
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
+
+/// \copydoc is_trivially_relocatable
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+/// std::allocator is empty and hence trivially relocatable
+template <typename T>
+struct is_trivially_relocatable<std::allocator<T>> : std::true_type
+{
+};
+
+/*!
+ * \brief relocate n objects from first to the uninitialised memory at dest
+ *
+ * Trivially relocatable objects are copied with memcpy. Other objects are
+ * move constructed at dest and destroyed at first. The ranges must not
+ * overlap.
+ *
+ * \note If a move constructor throws, the objects already relocated are
+ *       destroyed and the source is left partially moved-from.
  *
- * \todo rethink use of std::allocator
+ * \return dest + n
  */
 template <typename T>
-class runtime_array final
+auto uninitialized_relocate_n(T* const first, std::size_t const n, T* const dest) -> T*
 {
+    if constexpr (is_trivially_relocatable_v<T>)
+    {
+        if (n not_eq 0)
+        {
+            std::memcpy(static_cast<void*>(dest), static_cast<void const*>(first), n * sizeof(T));
+        }
+    }
+    else
+    {
+        std::uninitialized_move_n(first, n, dest);
+        std::destroy_n(first, n);
+    }
+    return dest + n;
+}
+
+
+/*!
+ * \brief Fixed size array, that can be created at runtime.
+ *
+ * Memory is obtained from, and elements are constructed and destroyed by, an
+ * allocator via std::allocator_traits. The propagate_on_container_* traits of the
+ * allocator are respected by assignment and swap.
+ *
+ * \tparam T Type of stored elements.
+ * \tparam Allocator Allocator used for the elements, its pointer type must be T*.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class runtime_array final : private detail::allocator_holder<Allocator>
+{
+    /// base storing the allocator
+    using allocator_base = detail::allocator_holder<Allocator>;
+
+    /// traits of the used allocator
+    using allocator_traits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<T, typename allocator_traits::value_type>, "Allocator::value_type must be T");
+    static_assert(std::is_same_v<T*, typename allocator_traits::pointer>, "fancy pointers are not supported");
+
   public:
     /// size type
     using size_type = std::size_t;
@@ -44,6 +667,9 @@ class runtime_array final
     /// alias for T
     using value_type = T;
 
+    /// alias for Allocator
+    using allocator_type = Allocator;
+
     /// alias for T&
     using reference = T&;
 
@@ -68,6 +694,13 @@ class runtime_array final
     /// alias for T const* for reversed iteration
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+    /*!
+     * \brief guaranteed alignment of data()
+     *
+     * alignof(T), or Allocator::alignment if the allocator provides a larger one.
+     */
+    static constexpr std::size_t alignment = detail::allocator_alignment<Allocator>::value;
+
     /*!
      * \brief default ctor for empty array
      *
@@ -75,18 +708,92 @@ class runtime_array final
      */
     runtime_array() = default;
 
+    /*!
+     * \brief create empty array using given allocator
+     *
+     * \param alloc allocator used for later assigned elements
+     */
+    explicit runtime_array(allocator_type const& alloc) noexcept
+        : allocator_base{alloc}
+    {
+    }
+
     /*!
      * \brief create with given size
      *
+     * Elements are default-initialised, unless the allocator provides its own
+     * construct(), which is then used without arguments.
+     * Use for_overwrite or value_initialise to state the intent explicitly.
+     *
      * \param n number of elements
+     * \param alloc allocator to use
+     */
+    explicit runtime_array(size_type const n,
+                           allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{allocate(m_size)}
+    {
+        initialise([this](pointer const p, size_type) { construct_at(p); });
+    }
+
+    /*!
+     * \brief create with given size, elements will be overwritten
+     *
+     * Trivially default constructible elements are not initialised at all,
+     * neither by the array nor by the allocator. Other elements are
+     * default-initialised.
+     *
+     * \param n number of elements
+     * \param alloc allocator to use
+     */
+    runtime_array(size_type const n,
+                  for_overwrite_t,
+                  allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{allocate(m_size)}
+    {
+        if constexpr (not std::is_trivially_default_constructible_v<value_type>)
+        {
+            initialise([this](pointer const p, size_type) { construct_at(p); });
+        }
+    }
+
+    /*!
+     * \brief create with given size, elements are value-initialised
      *
-     * \todo is uninitialized_default_construct_n correct?
+     * Arithmetic types, enums and pointers are zeroed, if the allocator does
+     * not provide its own construct(). Allocators providing
+     * allocate_zeroed(n) are asked for zeroed memory, so nothing has to be
+     * written (e.g. page_allocator hands out fresh pages of the operating
+     * system). Otherwise a single memset is used.
+     *
+     * \param n number of elements
+     * \param alloc allocator to use
      */
-    explicit runtime_array(size_type const n)
-        : m_size{n}
-        , m_data{std::allocator<value_type>{}.allocate(m_size)}
+    runtime_array(size_type const n,
+                  value_initialise_t,
+                  allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{uses_zeroed_memory ? allocate_zeroed(m_size) : allocate(m_size)}
     {
-        std::uninitialized_default_construct_n(m_data, m_size);
+        if constexpr (uses_zeroed_memory)
+        {
+            return;
+        }
+        else if constexpr (detail::is_zero_initialisable<value_type> and not detail::has_default_construct<allocator_type, value_type>)
+        {
+            if (m_data not_eq nullptr)
+            {
+                std::memset(m_data, 0, m_size * sizeof(value_type));
+            }
+        }
+        else
+        {
+            initialise([this](pointer const p, size_type) { allocator_traits::construct(this->allocator(), p); });
+        }
     }
 
     /*!
@@ -94,25 +801,102 @@ class runtime_array final
      *
      * \param n number of elements
      * \param value value used to initialise elements
+     * \param alloc allocator to use
      */
     runtime_array(size_type const n,
-                  const_reference value)
-        : m_size{n}
-        , m_data{std::allocator<value_type>{}.allocate(m_size)}
+                  const_reference value,
+                  allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{allocate(m_size)}
     {
-        std::uninitialized_fill_n(m_data, n, value);
+        initialise([this, &value](pointer const p, size_type) { construct_at(p, value); });
+    }
+
+    /*!
+     * \brief create with given size, element i is constructed from f(i)
+     *
+     * Each element is constructed directly in the uninitialised memory, so T
+     * needs no default ctor. If f returns T, not even a move is needed (unless
+     * the allocator provides its own construct()).
+     * If f or a ctor throws, the elements created so far are destroyed and
+     * the memory is released.
+     *
+     * \param n number of elements
+     * \param f function called with the index of each element, in ascending order
+     * \param alloc allocator to use
+     */
+    template <typename F,
+              typename = std::enable_if_t<std::is_invocable_v<F&, size_type>>>
+    runtime_array(size_type const n,
+                  generate_t,
+                  F&& f,
+                  allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{allocate(m_size)}
+    {
+        initialise([this, &f](pointer const p, size_type const i) { construct_result(p, f, i); });
     }
 
     /*!
      * \brief create array and fill with initializer list content
      *
      * \param il elements used to initialise
+     * \param alloc allocator to use
+     */
+    runtime_array(std::initializer_list<value_type> il,
+                  allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{il.size()}
+        , m_data{allocate(m_size)}
+    {
+        copy_from(il.begin());
+    }
+
+    /*!
+     * \brief create with given size and initialise with value, using several threads
+     *
+     * \param policy how to split the work
+     * \param n number of elements
+     * \param value value used to initialise elements
+     * \param alloc allocator to use
+     */
+    runtime_array(parallel_t const policy,
+                  size_type const n,
+                  const_reference value,
+                  allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{allocate(m_size)}
+    {
+        initialise(policy, [this, &value](pointer const p, size_type) { construct_at(p, value); });
+    }
+
+    /*!
+     * \brief create with given size, element i is constructed from f(i), using several threads
+     *
+     * Like runtime_array(n, generate, f), but f is called concurrently. Each
+     * thread creates a consecutive part of the array, so on NUMA systems the
+     * memory of that part is placed next to the thread ("first touch").
+     *
+     * \param policy how to split the work
+     * \param n number of elements
+     * \param f thread-safe function called once with the index of each element
+     * \param alloc allocator to use
      */
-    runtime_array(std::initializer_list<value_type> il)
-        : m_size{il.size()}
-        , m_data{std::allocator<value_type>{}.allocate(m_size)}
+    template <typename F,
+              typename = std::enable_if_t<std::is_invocable_v<F&, size_type>>>
+    runtime_array(parallel_t const policy,
+                  size_type const n,
+                  generate_t,
+                  F&& f,
+                  allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{allocate(m_size)}
     {
-        std::uninitialized_copy_n(il.begin(), m_size, m_data);
+        initialise(policy, [this, &f](pointer const p, size_type const i) { construct_result(p, f, i); });
     }
 
     /*!
@@ -120,57 +904,225 @@ class runtime_array final
      *
      * \param ptr pointer to source data
      * \param n number of elements to copy
+     * \param alloc allocator to use
      */
-    runtime_array(const_pointer ptr, size_type const n)
-        : m_size{n}
-        , m_data{std::allocator<value_type>{}.allocate(m_size)}
+    runtime_array(const_pointer ptr,
+                  size_type const n,
+                  allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{allocate(m_size)}
     {
-        std::uninitialized_copy_n(ptr, m_size, m_data);
+        copy_from(ptr);
+    }
+
+    /*!
+     * \brief create array and fill with pointed-to elements, using several threads
+     *
+     * Trivially copyable elements are copied with one memcpy per chunk.
+     *
+     * \param policy how to split the work
+     * \param ptr pointer to source data
+     * \param n number of elements to copy
+     * \param alloc allocator to use
+     */
+    runtime_array(parallel_t const policy,
+                  const_pointer ptr,
+                  size_type const n,
+                  allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{allocate(m_size)}
+    {
+        if constexpr (copies_bytes)
+        {
+            if (m_size not_eq 0)
+            {
+                detail::parallel_chunks(m_size, policy.chunks(m_size, sizeof(value_type)),
+                                        [this, ptr](std::size_t, std::size_t const begin, std::size_t const end)
+                                        {
+                                            std::memcpy(m_data + begin, ptr + begin, (end - begin) * sizeof(value_type));
+                                        });
+            }
+        }
+        else
+        {
+            initialise(policy, [this, ptr](pointer const p, size_type const i) { construct_at(p, ptr[i]); });
+        }
     }
 
     /*!
      * \brief create array and fill with range
      *
+     * Forward iterators are traversed twice, once to count the elements.
+     * Input iterators are read once: elements are collected in memory that
+     * grows geometrically and are moved into memory of the exact size in
+     * the end. Elements from std::move_iterators are moved.
+     *
      * \param begin iterator to first element
      * \param end iterator to one-past-last element
+     * \param alloc allocator to use
      *
-     * \tparam I iterator type, must be at least forward iterator
+     * \tparam I iterator type, must be at least input iterator
      *
      * \note if std::distance(begin, end) is negative, behaviour is undefined
      */
     template <typename I,
-              typename = std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<I>::iterator_category>, void*>>
-    runtime_array(I begin, I end)
-    : m_size{static_cast<size_type> (std::distance(begin, end))}
-    , m_data{std::allocator<value_type>{}.allocate(m_size)}
+              typename = std::enable_if_t<detail::is_iterator_of<I, std::input_iterator_tag>::value, void*>>
+    runtime_array(I begin, I end,
+                  allocator_type const& alloc = allocator_type{})
+    : allocator_base{alloc}
+    {
+        if constexpr (detail::is_iterator_of<I, std::forward_iterator_tag>::value)
+        {
+            m_size = static_cast<size_type>(std::distance(begin, end));
+            m_data = allocate(m_size);
+            copy_from(begin);
+        }
+        else
+        {
+            collect(begin, end, 0);
+        }
+    }
+
+    /*!
+     * \brief create array and fill with range of a probable size
+     *
+     * The range is read once. If it has size_hint elements, they are
+     * constructed in place. Otherwise the memory grows geometrically and the
+     * elements are moved into memory of the exact size in the end.
+     *
+     * \param begin iterator to first element
+     * \param end iterator to one-past-last element
+     * \param size_hint expected number of elements
+     * \param alloc allocator to use
+     *
+     * \tparam I iterator type, must be at least input iterator
+     */
+    template <typename I,
+              typename = std::enable_if_t<detail::is_iterator_of<I, std::input_iterator_tag>::value, void*>>
+    runtime_array(I begin, I end, size_type const size_hint,
+                  allocator_type const& alloc = allocator_type{})
+    : allocator_base{alloc}
     {
-        std::uninitialized_copy(begin, end, m_data);
+        collect(begin, end, size_hint);
+    }
+
+    /*!
+     * \brief create array from the first n elements of a range
+     *
+     * The range is read once and first is incremented n - 1 times only, so
+     * no element after the last one is read from a stream.
+     *
+     * \param first iterator to first element, at least n elements must follow
+     * \param n number of elements
+     * \param alloc allocator to use
+     *
+     * \tparam I iterator type, must be at least input iterator
+     */
+    template <typename I,
+              typename = std::enable_if_t<detail::is_iterator_of<I, std::input_iterator_tag>::value, void*>>
+    runtime_array(I first, size_type const n,
+                  allocator_type const& alloc = allocator_type{})
+    : allocator_base{alloc}
+    , m_size{n}
+    , m_data{allocate(m_size)}
+    {
+        copy_from(first);
+    }
+
+    /*!
+     * \brief create array and fill with the elements of a range
+     *
+     * If the size of range is known (std::ranges::sized_range in C++20,
+     * std::size otherwise), it is read once into memory of the exact size.
+     * Otherwise it is handled like an input range.
+     *
+     * \param range range to copy, anything std::begin and std::end accept
+     * \param alloc allocator to use
+     */
+    template <typename R>
+    runtime_array(from_range_t, R&& range, allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+    {
+        if constexpr (detail::is_sized_range<R>)
+        {
+            m_size = static_cast<size_type>(detail::range_size(range));
+            m_data = allocate(m_size);
+            copy_from(std::begin(range));
+        }
+        else
+        {
+            collect(std::begin(range), std::end(range), 0);
+        }
     }
 
     /// destroy objects and release memory
     ~runtime_array()
     {
-        std::destroy_n(m_data, m_size);
-        std::allocator<value_type>{}.deallocate(m_data, m_size);
+        destroy_n(m_data, m_size);
+        deallocate();
     }
 
-    /// copy construct
+    /// copy construct, allocator is obtained by select_on_container_copy_construction
     runtime_array(runtime_array const& orig)
-        : m_size{orig.size()}
-        , m_data{std::allocator<value_type>{}.allocate(m_size)}
+        : runtime_array(orig, allocator_traits::select_on_container_copy_construction(orig.get_allocator()))
+    {
+    }
+
+    /// copy construct using given allocator
+    runtime_array(runtime_array const& orig, allocator_type const& alloc)
+        : allocator_base{alloc}
+        , m_size{orig.size()}
+        , m_data{allocate(m_size)}
+    {
+        copy_from(orig.data());
+    }
+
+    /*!
+     * \brief copy construct using several threads
+     *
+     * \param policy how to split the work
+     * \param orig array to copy
+     */
+    runtime_array(parallel_t const policy, runtime_array const& orig)
+        : runtime_array(policy, orig.data(), orig.size(),
+                        allocator_traits::select_on_container_copy_construction(orig.get_allocator()))
     {
-        std::uninitialized_copy_n(orig.data(), size(), m_data);
     }
 
     /// move construct, orig will be empty
-    runtime_array(runtime_array&& orig)
-        : m_size{orig.m_size}
-    , m_data{orig.m_data}
+    runtime_array(runtime_array&& orig) noexcept
+        : allocator_base{std::move(orig.allocator())}
+        , m_size{orig.m_size}
+        , m_data{orig.m_data}
     {
         orig.m_size = 0;
         orig.m_data = nullptr;
     }
 
+    /*!
+     * \brief move construct using given allocator
+     *
+     * If alloc compares equal to the allocator of orig, the elements are taken
+     * over and orig will be empty. Otherwise the elements are moved one by one
+     * into memory obtained from alloc and orig keeps its (moved-from) elements.
+     */
+    runtime_array(runtime_array&& orig, allocator_type const& alloc) noexcept(allocator_traits::is_always_equal::value)
+        : allocator_base{alloc}
+    {
+        if (allocator_traits::is_always_equal::value or get_allocator() == orig.get_allocator())
+        {
+            std::swap(m_size, orig.m_size);
+            std::swap(m_data, orig.m_data);
+            return;
+        }
+
+        m_data = allocate(orig.size());
+        m_size = orig.size();
+        initialise([this, &orig](pointer const p, size_type const i) { construct_at(p, std::move(orig[i])); });
+    }
+
     /// copy assign
     runtime_array& operator=(runtime_array const& rhs)
     {
@@ -179,31 +1131,78 @@ class runtime_array final
             return *this;
         }
 
-        auto tmp = rhs;
-        swap(tmp);
-
+        constexpr auto propagate = allocator_traits::propagate_on_container_copy_assignment::value;
+        if constexpr (assigns_in_place)
+        {
+            // reuse the buffer, if it fits and would not be released by propagation
+            if (size() == rhs.size() and (not propagate or allocator_traits::is_always_equal::value
+                                          or get_allocator() == rhs.get_allocator()))
+            {
+                if constexpr (propagate)
+                {
+                    this->allocator() = rhs.allocator();
+                }
+                copy_assign_from(rhs.data());
+                return *this;
+            }
+        }
+
+        auto tmp = runtime_array(rhs, propagate ? rhs.get_allocator() : get_allocator());
+        swap_storage(tmp);
+        if constexpr (propagate)
+        {
+            swap_allocator(tmp);
+        }
+
         return *this;
     }
 
-    /// move assign
-    runtime_array& operator=(runtime_array&& rhs)
+    /*!
+     * \brief move assign
+     *
+     * Only allocates, if the allocator does not propagate and compares unequal.
+     */
+    runtime_array& operator=(runtime_array&& rhs) noexcept(allocator_traits::propagate_on_container_move_assignment::value
+                                                           or allocator_traits::is_always_equal::value)
     {
         if (this == std::addressof(rhs))
         {
             return *this;
         }
 
-        auto tmp = runtime_array{std::move(rhs)};
-        swap(tmp);
+        if constexpr (allocator_traits::propagate_on_container_move_assignment::value)
+        {
+            auto tmp = runtime_array{std::move(rhs)};
+            swap_storage(tmp);
+            swap_allocator(tmp);
+        }
+        else
+        {
+            auto tmp = runtime_array(std::move(rhs), get_allocator());
+            swap_storage(tmp);
+        }
 
         return *this;
     }
 
-    /// swap with another runtime_array
+    /*!
+     * \brief swap with another runtime_array
+     *
+     * \note If the allocator does not propagate on swap, both allocators must compare equal.
+     */
     void swap(runtime_array& rhs) noexcept
     {
-        std::swap(m_size, rhs.m_size);
-        std::swap(m_data, rhs.m_data);
+        if constexpr (allocator_traits::propagate_on_container_swap::value)
+        {
+            swap_allocator(rhs);
+        }
+        swap_storage(rhs);
+    }
+
+    /// get a copy of the used allocator
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type
+    {
+        return this->allocator();
     }
 
     /// check for emptiness
@@ -218,10 +1217,14 @@ class runtime_array final
         return m_size;
     }
 
-    /// get direct access to the data
+    /// get direct access to the data, aligned to at least alignment
     [[nodiscard]] auto data() const noexcept -> const_pointer
     {
+#if defined(__GNUC__)
+        return static_cast<const_pointer>(__builtin_assume_aligned(m_data, alignment));
+#else
         return m_data;
+#endif
     }
 
     /// \copydoc data()
@@ -370,13 +1373,511 @@ class runtime_array final
         return reverse_iterator{begin()};
     }
 
+    /*!
+     * \brief change the number of elements
+     *
+     * The first min(size(), new_size) elements are kept, new elements are
+     * default-initialised as by runtime_array(n). All iterators, pointers and
+     * references are invalidated.
+     *
+     * For trivially relocatable elements, an allocator with a member
+     * reallocate(p, old_n, new_n) resizes the memory itself, e.g.
+     * page_allocator remaps the pages instead of copying them. Otherwise new
+     * memory is allocated and the elements are relocated into it: trivially
+     * relocatable ones with memcpy, others are moved, or copied if their move
+     * ctor may throw.
+     *
+     * \param new_size new number of elements
+     * \throw std::bad_alloc or any exception of a new element's ctor, the
+     *        array is unchanged then
+     */
+    void reallocate(size_type const new_size)
+    {
+        if (new_size == m_size)
+        {
+            return;
+        }
+        if (new_size == 0)
+        {
+            destroy_n(m_data, m_size);
+            deallocate();
+            m_size = 0;
+            m_data = nullptr;
+            return;
+        }
+
+        if constexpr (reallocates_in_place)
+        {
+            constexpr auto destroys_elements = not std::is_trivially_destructible_v<value_type>;
+            if (m_size not_eq 0 and (new_size > m_size or not destroys_elements))
+            {
+                m_data = this->allocator().reallocate(m_data, m_size, new_size);
+                for (auto i = m_size; i < new_size; ++i)
+                {
+                    construct_at(m_data + i);
+                }
+                m_size = new_size;
+                return;
+            }
+        }
+
+        auto const kept = std::min(m_size, new_size);
+        auto tmp = runtime_array(this->allocator());
+        tmp.m_data = tmp.allocate(new_size);
+        tmp.m_size = new_size;
+        if constexpr (relocates_bytes)
+        {
+            if (kept not_eq 0)
+            {
+                std::memcpy(static_cast<void*>(tmp.m_data), static_cast<void const*>(m_data), kept * sizeof(value_type));
+            }
+            tmp.initialise(kept, [&tmp](pointer const p, size_type) { tmp.construct_at(p); });
+            destroy_n(m_data + kept, m_size - kept);
+        }
+        else
+        {
+            // new elements first: nothing is moved away before they are all constructed
+            tmp.initialise(kept, [&tmp](pointer const p, size_type) { tmp.construct_at(p); });
+            auto i = size_type{0};
+            try
+            {
+                for (; i < kept; ++i)
+                {
+                    tmp.construct_at(tmp.m_data + i, std::move_if_noexcept(m_data[i]));
+                }
+            }
+            catch (...)
+            {
+                // only copies can throw, the kept elements are unchanged
+                tmp.destroy_n(tmp.m_data, i);
+                tmp.destroy_n(tmp.m_data + kept, new_size - kept);
+                tmp.deallocate();
+                tmp.m_size = 0;
+                tmp.m_data = nullptr;
+                throw;
+            }
+            destroy_n(m_data, m_size);
+        }
+
+        deallocate();
+        m_size = 0;
+        m_data = nullptr;
+        swap_storage(tmp);
+    }
+
     /// assign given value to all elements
     void fill(value_type const& val)
     {
         std::fill_n(data(), size(), val);
     }
 
+    /*!
+     * \brief assign given value to all elements, using several threads
+     *
+     * \param policy how to split the work
+     * \param val value to assign
+     */
+    void fill(parallel_t const policy, value_type const& val)
+    {
+        detail::parallel_chunks(size(), policy.chunks(size(), sizeof(value_type)),
+                                [this, &val](std::size_t, std::size_t const begin, std::size_t const end)
+                                {
+                                    std::fill_n(data() + begin, end - begin, val);
+                                });
+    }
+
+    /*!
+     * \brief find the first element that differs from the element of other at the same index
+     *
+     * \param other array to compare with
+     * \return index of the first element that is not equal, or the smaller size
+     *         if one array is a prefix of the other
+     */
+    [[nodiscard]] auto mismatch(runtime_array const& other) const -> size_type
+    {
+        auto const n = std::min(size(), other.size());
+        return (n == 0) ? 0 : detail::first_mismatch(data(), other.data(), n);
+    }
+
+    /*!
+     * \brief compare lexicographically in a single pass
+     *
+     * Elements are compared with operator<, as by std::lexicographical_compare.
+     *
+     * \param other array to compare with
+     * \return -1 if *this is less than other, 1 if it is greater, 0 otherwise
+     */
+    [[nodiscard]] auto compare(runtime_array const& other) const -> int
+    {
+        return detail::lexicographical_order(data(), size(), other.data(), other.size());
+    }
+
   private:
+    /// elements are copy constructed by copying their bytes
+    static constexpr bool copies_bytes = std::is_trivially_copyable_v<value_type>
+                                         and not (detail::has_construct_impl<void, allocator_type, pointer, value_type const&>::value
+                                                  and not detail::is_std_allocator<allocator_type>::value);
+
+    /*!
+     * \brief copy assignment of equally sized arrays assigns the elements
+     *
+     * Only for elements that cannot throw, so copy assignment keeps its strong
+     * exception guarantee.
+     */
+    static constexpr bool assigns_in_place = std::is_nothrow_copy_assignable_v<value_type>;
+
+    /// elements are relocated by copying their bytes
+    static constexpr bool relocates_bytes = is_trivially_relocatable_v<value_type>
+                                            and not detail::has_destroy<allocator_type, value_type>
+                                            and not (detail::has_construct_impl<void, allocator_type, pointer, value_type&&>::value
+                                                     and not detail::is_std_allocator<allocator_type>::value);
+
+    /// reallocate() lets the allocator resize the memory, creating new elements cannot throw
+    static constexpr bool reallocates_in_place = detail::has_reallocate<allocator_type>::value and relocates_bytes
+                                                 and std::is_nothrow_default_constructible_v<value_type>
+                                                 and not detail::has_default_construct<allocator_type, value_type>;
+
+    /// value-initialised elements are created by allocating zeroed memory
+    static constexpr bool uses_zeroed_memory = detail::has_allocate_zeroed<allocator_type>::value
+                                               and detail::is_zero_initialisable<value_type>
+                                               and not detail::has_default_construct<allocator_type, value_type>;
+
+    /// get memory for n elements, no memory is requested for n == 0
+    auto allocate(size_type const n) -> pointer
+    {
+        return (n == 0) ? nullptr : allocator_traits::allocate(this->allocator(), n);
+    }
+
+    /// get zeroed memory for n elements, only used if uses_zeroed_memory
+    auto allocate_zeroed(size_type const n) -> pointer
+    {
+        if constexpr (uses_zeroed_memory)
+        {
+            return (n == 0) ? nullptr : this->allocator().allocate_zeroed(n);
+        }
+        else
+        {
+            return allocate(n);
+        }
+    }
+
+    /// release the memory of the elements
+    void deallocate() noexcept
+    {
+        deallocate(m_data, m_size);
+    }
+
+    /// release memory for n elements at p
+    void deallocate(pointer const p, size_type const n) noexcept
+    {
+        if (p not_eq nullptr)
+        {
+            allocator_traits::deallocate(this->allocator(), p, n);
+        }
+    }
+
+    /// construct a single element at p
+    template <typename... Args>
+    void construct_at(pointer const p, Args&&... args)
+    {
+        if constexpr (sizeof...(Args) == 0 and not detail::has_default_construct<allocator_type, value_type>)
+        {
+            ::new (static_cast<void*>(p)) value_type;
+        }
+        else
+        {
+            allocator_traits::construct(this->allocator(), p, std::forward<Args>(args)...);
+        }
+    }
+
+    /// construct a single element at p from the result of f(i)
+    template <typename F>
+    void construct_result(pointer const p, F& f, size_type const i)
+    {
+        if constexpr (detail::has_construct_impl<void, allocator_type, pointer, std::invoke_result_t<F&, size_type>>::value
+                      and not detail::is_std_allocator<allocator_type>::value)
+        {
+            allocator_traits::construct(this->allocator(), p, f(i));
+        }
+        else
+        {
+            ::new (static_cast<void*>(p)) value_type(f(i));
+        }
+    }
+
+    /*!
+     * \brief destroy n elements starting at first
+     *
+     * Nothing is done for trivially destructible elements, unless the allocator
+     * has its own destroy().
+     */
+    void destroy_n(pointer const first, size_type const n) noexcept
+    {
+        if constexpr (not std::is_trivially_destructible_v<value_type> or detail::has_destroy<allocator_type, value_type>)
+        {
+            for (auto i = size_type{0}; i < n; ++i)
+            {
+                allocator_traits::destroy(this->allocator(), first + i);
+            }
+        }
+    }
+
+    /*!
+     * \brief construct all elements by calling init(pointer, index)
+     *
+     * If init throws, all elements constructed so far are destroyed
+     * and the memory is released before the exception is rethrown.
+     */
+    template <typename Init>
+    void initialise(Init&& init)
+    {
+        initialise(size_type{0}, std::forward<Init>(init));
+    }
+
+    /*!
+     * \brief construct the elements from index first on by calling init(pointer, index)
+     *
+     * The elements before first are not touched, not even if init throws.
+     */
+    template <typename Init>
+    void initialise(size_type const first, Init&& init)
+    {
+        auto i = first;
+        try
+        {
+            for (; i < m_size; ++i)
+            {
+                init(m_data + i, i);
+            }
+        }
+        catch (...)
+        {
+            destroy_n(m_data + first, i - first);
+            deallocate();
+            m_size = 0;
+            m_data = nullptr;
+            throw;
+        }
+    }
+
+    /*!
+     * \brief construct all elements by calling init(pointer, index), using several threads
+     *
+     * If init throws, all elements constructed by any thread are destroyed
+     * and the memory is released before the first exception is rethrown.
+     */
+    template <typename Init>
+    void initialise(parallel_t const policy, Init&& init)
+    {
+        auto const chunks = policy.chunks(m_size, sizeof(value_type));
+        if (chunks == 1)
+        {
+            initialise(std::forward<Init>(init));
+            return;
+        }
+
+        // each thread counts locally and writes its slot once, so the slots are not falsely shared
+        auto constructed = std::vector<size_type>(chunks, 0);
+        try
+        {
+            detail::parallel_chunks(m_size, chunks,
+                                    [this, &init, &constructed](std::size_t const c, std::size_t const begin, std::size_t const end)
+                                    {
+                                        auto i = begin;
+                                        try
+                                        {
+                                            for (; i < end; ++i)
+                                            {
+                                                init(m_data + i, i);
+                                            }
+                                        }
+                                        catch (...)
+                                        {
+                                            constructed[c] = i - begin;
+                                            throw;
+                                        }
+                                        constructed[c] = end - begin;
+                                    });
+        }
+        catch (...)
+        {
+            for (auto c = std::size_t{0}; c < chunks; ++c)
+            {
+                destroy_n(m_data + detail::chunk_begin(m_size, chunks, c), constructed[c]);
+            }
+            deallocate();
+            m_size = 0;
+            m_data = nullptr;
+            throw;
+        }
+    }
+
+    /*!
+     * \brief construct all elements from range starting at first
+     *
+     * first is incremented size() - 1 times only, see runtime_array(first, n).
+     */
+    template <typename I>
+    void copy_from(I first)
+    {
+        if constexpr (copies_bytes and std::is_same_v<I, std::move_iterator<pointer>>)
+        {
+            copy_from(first.base());
+        }
+        else if constexpr (copies_bytes and (std::is_same_v<I, const_pointer> or std::is_same_v<I, pointer>))
+        {
+            if (m_size not_eq 0)
+            {
+                std::memcpy(m_data, first, m_size * sizeof(value_type));
+            }
+        }
+        else
+        {
+            initialise([this, &first](pointer const p, size_type const i)
+                       {
+                           if (i not_eq 0)
+                           {
+                               ++first;
+                           }
+                           construct_at(p, *first);
+                       });
+        }
+    }
+
+    /*!
+     * \brief construct all elements from a single pass range
+     *
+     * The memory starts with capacity elements and grows geometrically. In
+     * the end it is resized to the exact number of elements.
+     */
+    template <typename I, typename S>
+    void collect(I first, S const last, size_type capacity)
+    {
+        try
+        {
+            m_data = allocate(capacity);
+            for (; first not_eq last; ++first)
+            {
+                if (m_size == capacity)
+                {
+                    auto const grown = std::max(2 * capacity, std::max<size_type>(1, 1024 / sizeof(value_type)));
+                    resize_memory(capacity, grown);
+                    capacity = grown;
+                }
+                construct_at(m_data + m_size, *first);
+                ++m_size;
+            }
+            resize_memory(capacity, m_size);
+        }
+        catch (...)
+        {
+            destroy_n(m_data, m_size);
+            deallocate(m_data, capacity);
+            throw;
+        }
+    }
+
+    /*!
+     * \brief move the size() elements to memory for new_capacity elements
+     *
+     * The allocator resizes the memory itself if it can, see reallocate().
+     * If an exception is thrown, nothing is changed.
+     */
+    void resize_memory(size_type const capacity, size_type const new_capacity)
+    {
+        if (capacity == new_capacity)
+        {
+            return;
+        }
+
+        if constexpr (detail::has_reallocate<allocator_type>::value and relocates_bytes)
+        {
+            if (m_data not_eq nullptr and new_capacity not_eq 0)
+            {
+                m_data = this->allocator().reallocate(m_data, capacity, new_capacity);
+                return;
+            }
+        }
+
+        auto const moved = allocate(new_capacity);
+        try
+        {
+            relocate(m_data, m_size, moved);
+        }
+        catch (...)
+        {
+            deallocate(moved, new_capacity);
+            throw;
+        }
+        deallocate(m_data, capacity);
+        m_data = moved;
+    }
+
+    /*!
+     * \brief relocate n elements from first to the uninitialised memory at dest
+     *
+     * Elements are moved, or copied if their move ctor may throw, and the
+     * originals are destroyed. If an exception is thrown, the elements at first
+     * are unchanged.
+     */
+    void relocate(pointer const first, size_type const n, pointer const dest)
+    {
+        if constexpr (relocates_bytes)
+        {
+            if (n not_eq 0)
+            {
+                std::memcpy(static_cast<void*>(dest), static_cast<void const*>(first), n * sizeof(value_type));
+            }
+        }
+        else
+        {
+            auto i = size_type{0};
+            try
+            {
+                for (; i < n; ++i)
+                {
+                    construct_at(dest + i, std::move_if_noexcept(first[i]));
+                }
+            }
+            catch (...)
+            {
+                destroy_n(dest, i);
+                throw;
+            }
+            destroy_n(first, n);
+        }
+    }
+
+    /// copy assign all elements from array starting at first
+    void copy_assign_from(const_pointer const first) noexcept
+    {
+        if constexpr (std::is_trivially_copy_assignable_v<value_type>)
+        {
+            if (m_size not_eq 0)
+            {
+                std::memcpy(m_data, first, m_size * sizeof(value_type));
+            }
+        }
+        else
+        {
+            std::copy_n(first, m_size, m_data);
+        }
+    }
+
+    /// swap size and elements, but not the allocator
+    void swap_storage(runtime_array& rhs) noexcept
+    {
+        std::swap(m_size, rhs.m_size);
+        std::swap(m_data, rhs.m_data);
+    }
+
+    /// swap only the allocator
+    void swap_allocator(runtime_array& rhs) noexcept
+    {
+        using std::swap;
+        swap(this->allocator(), rhs.allocator());
+    }
+
     /// number of elements
     size_type m_size{0};
 
@@ -385,46 +1886,155 @@ class runtime_array final
 };
 
 
-/// compare whether equal
-/// \todo noexcept?
-template <typename T>
-bool operator==(runtime_array<T> const& lhs, runtime_array<T> const& rhs)
+/*!
+ * \brief runtime_array is trivially relocatable if its allocator is
+ *
+ * It consists of a pointer, a size and the allocator only.
+ */
+template <typename T, typename A>
+struct is_trivially_relocatable<runtime_array<T, A>> : is_trivially_relocatable<A>
+{
+};
+
+
+/*!
+ * \brief compare whether equal
+ *
+ * Integers, enums, pointers and bytes are compared with memcmp, other
+ * arithmetic types with a vectorisable loop.
+ *
+ * \todo noexcept?
+ */
+template <typename T, typename A>
+bool operator==(runtime_array<T, A> const& lhs, runtime_array<T, A> const& rhs)
 //noexcept(noexcept(T{} == T{}))
 {
     if (lhs.size() not_eq rhs.size())
     {
         return false;
     }
+    if (lhs.empty())
+    {
+        return true;
+    }
 
-    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    if constexpr (detail::is_bytewise_equal<T>)
+    {
+        return std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(T)) == 0;
+    }
+    else if constexpr (std::is_arithmetic_v<T>)
+    {
+        return detail::first_mismatch(lhs.data(), rhs.data(), lhs.size()) == lhs.size();
+    }
+    else
+    {
+        return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+    }
 }
 
 /// compare whether not equal
 /// \todo noexcept?
-template <typename T>
-bool operator!=(runtime_array<T> const& lhs, runtime_array<T> const& rhs)
+template <typename T, typename A>
+bool operator!=(runtime_array<T, A> const& lhs, runtime_array<T, A> const& rhs)
 //noexcept(noexcept(T{} == T{}))
 {
     return not (lhs == rhs);
 }
 
-/// check whether lhs < rhs
+/// check whether lhs < rhs, see runtime_array::compare()
 /// \todo noexcept?
-template <typename T>
-bool operator<(runtime_array<T> const& lhs, runtime_array<T> const& rhs)
+template <typename T, typename A>
+bool operator<(runtime_array<T, A> const& lhs, runtime_array<T, A> const& rhs)
 //noexcept(noexcept(T{} == T{}) and noexcept(T{} != T{}) and noexcept(T{} < T{}))
 {
-    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+    return lhs.compare(rhs) < 0;
+}
+
+/// check whether lhs > rhs, see runtime_array::compare()
+template <typename T, typename A>
+bool operator>(runtime_array<T, A> const& lhs, runtime_array<T, A> const& rhs)
+{
+    return lhs.compare(rhs) > 0;
+}
+
+/// check whether lhs <= rhs, see runtime_array::compare()
+template <typename T, typename A>
+bool operator<=(runtime_array<T, A> const& lhs, runtime_array<T, A> const& rhs)
+{
+    return lhs.compare(rhs) <= 0;
+}
+
+/// check whether lhs >= rhs, see runtime_array::compare()
+template <typename T, typename A>
+bool operator>=(runtime_array<T, A> const& lhs, runtime_array<T, A> const& rhs)
+{
+    return lhs.compare(rhs) >= 0;
+}
+
+#if defined(__cpp_impl_three_way_comparison) and __has_include(<compare>)
+/*!
+ * \brief three-way comparison, see runtime_array::compare()
+ *
+ * Floating-point elements are partially ordered: the first pair that is not
+ * equal decides, and if it contains NaN the arrays are unordered.
+ */
+template <typename T, typename A>
+auto operator<=>(runtime_array<T, A> const& lhs, runtime_array<T, A> const& rhs)
+    -> std::conditional_t<std::is_floating_point_v<T>, std::partial_ordering, std::weak_ordering>
+{
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        auto const n = std::min(lhs.size(), rhs.size());
+        auto const i = detail::first_mismatch(lhs.data(), rhs.data(), n);
+        return (i == n) ? (lhs.size() <=> rhs.size()) : (lhs[i] <=> rhs[i]);
+    }
+    else
+    {
+        return lhs.compare(rhs) <=> 0;
+    }
+}
+#endif
+
+
+/*!
+ * \brief create runtime_array, whose elements will be overwritten
+ *
+ * \param n number of elements
+ * \param alloc allocator to use
+ * \return runtime_array(n, for_overwrite, alloc)
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+auto make_runtime_array_for_overwrite(std::size_t const n, Allocator const& alloc = Allocator{}) -> runtime_array<T, Allocator>
+{
+    return runtime_array<T, Allocator>(n, for_overwrite, alloc);
 }
 
 
 /// free function swap, same as runtime_array::swap
-template <typename T>
-void swap(runtime_array<T>& lhs, runtime_array<T>& rhs) noexcept
+template <typename T, typename A>
+void swap(runtime_array<T, A>& lhs, runtime_array<T, A>& rhs) noexcept
 {
     lhs.swap(rhs);
 }
 
+
+#if __has_include(<memory_resource>)
+/*!
+ * \brief runtime_arrays using polymorphic memory resources
+ */
+namespace pmr
+{
+/*!
+ * \brief runtime_array using std::pmr::polymorphic_allocator
+ *
+ * Elements that are allocator-aware themselves (e.g. std::pmr::string) are
+ * constructed with the same memory resource.
+ */
+template <typename T>
+using runtime_array = bosswestfalen::runtime_array<T, std::pmr::polymorphic_allocator<T>>;
+} // namespace pmr
+#endif
+
 } // namespace bosswestfalen
 
 #endif
@@ -0,0 +1,242 @@
+/*!
+ * \file runtime_array_arena.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_RUNTIME_ARRAY_ARENA_HPP_
+#define BOSSWESTFALEN_RUNTIME_ARRAY_ARENA_HPP_
+
+
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+
+
+namespace bosswestfalen
+{
+/*!
+ * \brief Monotonic memory arena for many runtime_arrays.
+ *
+ * Memory is handed out from large blocks by bumping a pointer and is only
+ * given back all at once by release() or the destructor. Arrays created with
+ * an arena_allocator do not free anything themselves, and for trivially
+ * destructible elements their destructor does no work at all.
+ *
+ * \note The arena must outlive all arrays that use it.
+ */
+class runtime_array_arena final
+{
+  public:
+    /// size type
+    using size_type = std::size_t;
+
+    /// default size of the first block in bytes
+    static constexpr size_type default_block_size = 64 * 1024;
+
+    /*!
+     * \brief create arena
+     *
+     * No memory is requested until the first allocation.
+     *
+     * \param block_size size of the first block, following blocks grow geometrically
+     */
+    explicit runtime_array_arena(size_type const block_size = default_block_size) noexcept
+        : m_next_block_size{std::max(block_size, sizeof(block))}
+    {
+    }
+
+    /// release all memory
+    ~runtime_array_arena()
+    {
+        release();
+    }
+
+    /// arenas are not copyable
+    runtime_array_arena(runtime_array_arena const&) = delete;
+
+    /// arenas are not movable, the allocators refer to them
+    runtime_array_arena(runtime_array_arena&&) = delete;
+
+    /// arenas are not copyable
+    runtime_array_arena& operator=(runtime_array_arena const&) = delete;
+
+    /// arenas are not movable, the allocators refer to them
+    runtime_array_arena& operator=(runtime_array_arena&&) = delete;
+
+    /*!
+     * \brief get memory
+     *
+     * \param bytes number of bytes
+     * \param alignment alignment of the memory, must be a power of two
+     * \return pointer to the memory, never nullptr
+     */
+    [[nodiscard]] auto allocate(size_type const bytes, size_type const alignment) -> void*
+    {
+        if (auto const p = bump(bytes, alignment); p not_eq nullptr)
+        {
+            return p;
+        }
+
+        add_block(bytes + alignment);
+        return bump(bytes, alignment);
+    }
+
+    /*!
+     * \brief give all memory back
+     *
+     * \note All memory handed out before is invalid afterwards.
+     */
+    void release() noexcept
+    {
+        while (m_blocks not_eq nullptr)
+        {
+            auto const next = m_blocks->next;
+            ::operator delete(m_blocks);
+            m_blocks = next;
+        }
+        m_current = nullptr;
+        m_end = nullptr;
+        m_allocated = 0;
+    }
+
+    /// number of bytes requested from the system
+    [[nodiscard]] auto allocated() const noexcept -> size_type
+    {
+        return m_allocated;
+    }
+
+  private:
+    /// header at the beginning of each block
+    struct block
+    {
+        /// the block allocated before
+        block* next;
+    };
+
+    /// take memory from the current block, nullptr if it is too small
+    auto bump(size_type const bytes, size_type const alignment) noexcept -> void*
+    {
+        auto p = static_cast<void*>(m_current);
+        auto space = static_cast<size_type>(m_end - m_current);
+        if (std::align(alignment, bytes, p, space) == nullptr)
+        {
+            return nullptr;
+        }
+        m_current = static_cast<std::byte*>(p) + bytes;
+        return p;
+    }
+
+    /// request a new block with at least min_bytes usable bytes
+    void add_block(size_type const min_bytes)
+    {
+        auto const size = std::max(m_next_block_size, min_bytes + sizeof(block));
+        auto const memory = static_cast<std::byte*>(::operator new(size));
+        m_blocks = ::new (memory) block{m_blocks};
+        m_current = memory + sizeof(block);
+        m_end = memory + size;
+        m_allocated += size;
+        m_next_block_size = size * 2;
+    }
+
+    /// size of the next requested block
+    size_type m_next_block_size;
+
+    /// number of bytes requested from the system
+    size_type m_allocated{0};
+
+    /// list of all blocks, starting with the current one
+    block* m_blocks{nullptr};
+
+    /// next free byte in the current block
+    std::byte* m_current{nullptr};
+
+    /// end of the current block
+    std::byte* m_end{nullptr};
+};
+
+
+/*!
+ * \brief Allocator taking memory from a runtime_array_arena.
+ *
+ * deallocate() does nothing, the memory is given back by the arena.
+ * Like std::pmr::polymorphic_allocator, the allocator does not propagate,
+ * so assigned elements always end up in the arena of the target.
+ *
+ * \tparam T type of allocated elements
+ */
+template <typename T>
+class arena_allocator final
+{
+  public:
+    /// alias for T
+    using value_type = T;
+
+    /// implicit conversion from the arena
+    arena_allocator(runtime_array_arena& arena) noexcept
+        : m_arena{std::addressof(arena)}
+    {
+    }
+
+    /// rebind
+    template <typename U>
+    arena_allocator(arena_allocator<U> const& other) noexcept
+        : m_arena{std::addressof(other.arena())}
+    {
+    }
+
+    /// get memory for n elements from the arena
+    [[nodiscard]] auto allocate(std::size_t const n) -> T*
+    {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+        {
+            throw std::bad_array_new_length{};
+        }
+        return static_cast<T*>(m_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    /// does nothing, memory is released by the arena
+    void deallocate(T*, std::size_t) noexcept
+    {
+    }
+
+    /// the used arena
+    [[nodiscard]] auto arena() const noexcept -> runtime_array_arena&
+    {
+        return *m_arena;
+    }
+
+  private:
+    /// the used arena
+    runtime_array_arena* m_arena;
+};
+
+/// allocators are equal if they use the same arena
+template <typename T, typename U>
+bool operator==(arena_allocator<T> const& lhs, arena_allocator<U> const& rhs) noexcept
+{
+    return std::addressof(lhs.arena()) == std::addressof(rhs.arena());
+}
+
+/// allocators are equal if they use the same arena
+template <typename T, typename U>
+bool operator!=(arena_allocator<T> const& lhs, arena_allocator<U> const& rhs) noexcept
+{
+    return not (lhs == rhs);
+}
+
+
+/// runtime_array whose memory is taken from a runtime_array_arena
+template <typename T>
+using arena_runtime_array = runtime_array<T, arena_allocator<T>>;
+
+} // namespace bosswestfalen
+
+#endif
@@ -0,0 +1,601 @@
+/*!
+ * \file runtime_bitarray.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_RUNTIME_BITARRAY_HPP_
+#define BOSSWESTFALEN_RUNTIME_BITARRAY_HPP_
+
+
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace bosswestfalen
+{
+namespace detail
+{
+/*!
+ * \brief number of set bits in n words
+ *
+ * Without a popcnt instruction the builtin is a library call per word.
+ * Instead, the bits of each byte are counted in parallel and summed per
+ * byte for up to 31 words, which the compiler can vectorise.
+ */
+inline auto count_bits(std::uint64_t const* const words, std::size_t const n) noexcept -> std::size_t
+{
+    auto result = std::uint64_t{0};
+#if defined(__GNUC__) and defined(__POPCNT__)
+    for (auto w = std::size_t{0}; w < n; ++w)
+    {
+        result += static_cast<std::uint64_t>(__builtin_popcountll(words[w]));
+    }
+#else
+    auto w = std::size_t{0};
+    while (w < n)
+    {
+        auto const last = (n - w < 31) ? n : w + 31;
+        auto bytes = std::uint64_t{0};
+        for (; w < last; ++w)
+        {
+            auto word = words[w];
+            word -= (word >> 1) & 0x5555555555555555;
+            word = (word & 0x3333333333333333) + ((word >> 2) & 0x3333333333333333);
+            bytes += (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0f;
+        }
+        bytes = (bytes & 0x00ff00ff00ff00ff) + ((bytes >> 8) & 0x00ff00ff00ff00ff);
+        bytes += bytes >> 16;
+        bytes += bytes >> 32;
+        result += bytes & 0xffff;
+    }
+#endif
+    return static_cast<std::size_t>(result);
+}
+
+/// index of the lowest set bit of word, which must not be 0
+inline auto lowest_set_bit(std::uint64_t const word) noexcept -> std::size_t
+{
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctzll(word));
+#else
+    // the isolated bit times a de Bruijn sequence has a unique top 6 bits
+    constexpr unsigned char positions[64] = {
+        0,  1,  48, 2,  57, 49, 28, 3,  61, 58, 50, 42, 38, 29, 17, 4,  62, 55, 59, 36, 53, 51,
+        43, 22, 45, 39, 33, 30, 24, 18, 12, 5,  63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21,
+        44, 32, 23, 11, 46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9,  13, 8,  7,  6};
+    return positions[((word & (~word + 1)) * 0x03f79d71b4cb0a89) >> 58];
+#endif
+}
+} // namespace detail
+
+
+/*!
+ * \brief Fixed size array of bits, that can be created at runtime.
+ *
+ * Bits are packed into 64 bit words, i.e. one eighth of the memory of a
+ * runtime_array<bool>. Bulk operations (fill, count, and, or, xor, not)
+ * work on whole words, so the compiler can vectorise them and they run at
+ * memory bandwidth.
+ *
+ * Bit i is bit i % 64 of word i / 64. Unused bits of the last word are
+ * always 0.
+ *
+ * \tparam Allocator allocator of the words, its value_type must be std::uint64_t
+ */
+template <typename Allocator = std::allocator<std::uint64_t>>
+class runtime_bitarray final
+{
+  public:
+    /// type of the words holding the bits
+    using word_type = std::uint64_t;
+
+    /// type of the underlying storage
+    using container_type = runtime_array<word_type, Allocator>;
+
+    /// size type
+    using size_type = std::size_t;
+
+    /// a bit
+    using value_type = bool;
+
+    /// alias for Allocator
+    using allocator_type = Allocator;
+
+    /// value of a read-only bit
+    using const_reference = bool;
+
+    /// number of bits per word
+    static constexpr size_type bits_per_word = std::numeric_limits<word_type>::digits;
+
+    /// returned by find_first() and find_next() if there is no set bit
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    /// proxy reference to a bit
+    class reference final
+    {
+      public:
+        /// refer to the bits of word selected by mask
+        reference(word_type& word, word_type const mask) noexcept
+            : m_word{word}
+            , m_mask{mask}
+        {
+        }
+
+        /// copy the referenced bit, not the reference
+        reference(reference const&) noexcept = default;
+
+        /// get the bit
+        operator bool() const noexcept
+        {
+            return (m_word & m_mask) not_eq 0;
+        }
+
+        /// set the bit to value
+        auto operator=(bool const value) noexcept -> reference&
+        {
+            m_word = value ? (m_word | m_mask) : (m_word & ~m_mask);
+            return *this;
+        }
+
+        /// set the bit to the bit referenced by rhs
+        auto operator=(reference const& rhs) noexcept -> reference&
+        {
+            return *this = static_cast<bool>(rhs);
+        }
+
+        /// invert the bit
+        auto flip() noexcept -> reference&
+        {
+            m_word ^= m_mask;
+            return *this;
+        }
+
+      private:
+        /// word containing the bit
+        word_type& m_word;
+
+        /// mask selecting the bit
+        word_type m_mask;
+    };
+
+    /// create empty bit array
+    runtime_bitarray() = default;
+
+    /*!
+     * \brief create with n bits, all 0
+     *
+     * The words are value-initialised, so allocators providing zeroed memory
+     * need not write anything.
+     *
+     * \param n number of bits
+     * \param alloc allocator to use
+     */
+    explicit runtime_bitarray(size_type const n, allocator_type const& alloc = allocator_type{})
+        : m_words(words_for(n), value_initialise, alloc)
+        , m_size{n}
+    {
+    }
+
+    /*!
+     * \brief create with n bits, all equal to value
+     *
+     * \param n number of bits
+     * \param value value of the bits
+     * \param alloc allocator to use
+     */
+    runtime_bitarray(size_type const n, bool const value, allocator_type const& alloc = allocator_type{})
+        : m_words(words_for(n), value ? ~word_type{0} : word_type{0}, alloc)
+        , m_size{n}
+    {
+        clear_unused_bits();
+    }
+
+    /*!
+     * \brief create with the given bits
+     *
+     * \param il the bits
+     * \param alloc allocator to use
+     */
+    runtime_bitarray(std::initializer_list<bool> const il, allocator_type const& alloc = allocator_type{})
+        : runtime_bitarray(il.size(), alloc)
+    {
+        auto pos = size_type{0};
+        for (auto const bit : il)
+        {
+            set(pos++, bit);
+        }
+    }
+
+    /// copy construct
+    runtime_bitarray(runtime_bitarray const&) = default;
+
+    /// move construct, orig will be empty
+    runtime_bitarray(runtime_bitarray&& orig) noexcept
+        : m_words{std::move(orig.m_words)}
+        , m_size{std::exchange(orig.m_size, 0)}
+    {
+    }
+
+    /// copy assign
+    runtime_bitarray& operator=(runtime_bitarray const&) = default;
+
+    /// move assign, rhs will be empty unless its words had to be copied to a different allocator
+    runtime_bitarray& operator=(runtime_bitarray&& rhs) noexcept(std::is_nothrow_move_assignable_v<container_type>)
+    {
+        m_words = std::move(rhs.m_words);
+        m_size = rhs.m_size;
+        if (rhs.m_words.empty())
+        {
+            rhs.m_size = 0;
+        }
+        return *this;
+    }
+
+    /// get the allocator
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type
+    {
+        return m_words.get_allocator();
+    }
+
+    /// check for emptiness
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /// get number of bits
+    [[nodiscard]] auto size() const noexcept -> size_type
+    {
+        return m_size;
+    }
+
+    /// get number of words
+    [[nodiscard]] auto word_count() const noexcept -> size_type
+    {
+        return m_words.size();
+    }
+
+    /// get pointer to the first word
+    [[nodiscard]] auto data() const noexcept -> word_type const*
+    {
+        return m_words.data();
+    }
+
+    /// \copydoc data() const
+    [[nodiscard]] auto data() noexcept -> word_type*
+    {
+        return m_words.data();
+    }
+
+    /// get bit at pos, no bounds checking is performed
+    [[nodiscard]] auto operator[](size_type const pos) const noexcept -> const_reference
+    {
+        return test(pos);
+    }
+
+    /// \copydoc operator[](size_type) const
+    [[nodiscard]] auto operator[](size_type const pos) noexcept -> reference
+    {
+        return reference{m_words[pos / bits_per_word], mask(pos)};
+    }
+
+    /*!
+     * \brief get bit at pos with bounds checking
+     *
+     * \throw std::out_of_range if pos is not less than size()
+     */
+    [[nodiscard]] auto at(size_type const pos) const -> const_reference
+    {
+        if (size() <= pos)
+        {
+            throw std::out_of_range{""};
+        }
+        return test(pos);
+    }
+
+    /// \copydoc at(size_type) const
+    [[nodiscard]] auto at(size_type const pos) -> reference
+    {
+        if (size() <= pos)
+        {
+            throw std::out_of_range{""};
+        }
+        return operator[](pos);
+    }
+
+    /// get bit at pos, no bounds checking is performed
+    [[nodiscard]] auto test(size_type const pos) const noexcept -> bool
+    {
+        return (m_words[pos / bits_per_word] & mask(pos)) not_eq 0;
+    }
+
+    /// set bit at pos to 1, no bounds checking is performed
+    void set(size_type const pos) noexcept
+    {
+        m_words[pos / bits_per_word] |= mask(pos);
+    }
+
+    /// set bit at pos to value, no bounds checking is performed
+    void set(size_type const pos, bool const value) noexcept
+    {
+        operator[](pos) = value;
+    }
+
+    /// set bit at pos to 0, no bounds checking is performed
+    void reset(size_type const pos) noexcept
+    {
+        m_words[pos / bits_per_word] &= ~mask(pos);
+    }
+
+    /// invert bit at pos, no bounds checking is performed
+    void flip(size_type const pos) noexcept
+    {
+        m_words[pos / bits_per_word] ^= mask(pos);
+    }
+
+    /// set all bits to value, word by word
+    void fill(bool const value) noexcept
+    {
+        std::fill_n(data(), word_count(), value ? ~word_type{0} : word_type{0});
+        clear_unused_bits();
+    }
+
+    /// set all bits to 1
+    void set() noexcept
+    {
+        fill(true);
+    }
+
+    /// set all bits to 0
+    void reset() noexcept
+    {
+        fill(false);
+    }
+
+    /// invert all bits
+    void flip() noexcept
+    {
+        auto const words = data();
+        for (auto w = size_type{0}; w < word_count(); ++w)
+        {
+            words[w] = ~words[w];
+        }
+        clear_unused_bits();
+    }
+
+    /// get number of set bits
+    [[nodiscard]] auto count() const noexcept -> size_type
+    {
+        return detail::count_bits(data(), word_count());
+    }
+
+    /// check whether all bits are set, true if empty
+    [[nodiscard]] auto all() const noexcept -> bool
+    {
+        return count() == size();
+    }
+
+    /// check whether any bit is set
+    [[nodiscard]] auto any() const noexcept -> bool
+    {
+        return std::any_of(data(), data() + word_count(), [](word_type const word) { return word not_eq 0; });
+    }
+
+    /// check whether no bit is set
+    [[nodiscard]] auto none() const noexcept -> bool
+    {
+        return not any();
+    }
+
+    /// get position of the first set bit, or npos
+    [[nodiscard]] auto find_first() const noexcept -> size_type
+    {
+        return find_from(0);
+    }
+
+    /// get position of the first set bit after pos, or npos
+    [[nodiscard]] auto find_next(size_type const pos) const noexcept -> size_type
+    {
+        return (pos >= size()) ? npos : find_from(pos + 1);
+    }
+
+    /*!
+     * \brief bitwise and with rhs
+     *
+     * \throw std::invalid_argument if the sizes differ
+     */
+    auto operator&=(runtime_bitarray const& rhs) -> runtime_bitarray&
+    {
+        combine(rhs, [](word_type const a, word_type const b) { return a & b; });
+        return *this;
+    }
+
+    /*!
+     * \brief bitwise or with rhs
+     *
+     * \throw std::invalid_argument if the sizes differ
+     */
+    auto operator|=(runtime_bitarray const& rhs) -> runtime_bitarray&
+    {
+        combine(rhs, [](word_type const a, word_type const b) { return a | b; });
+        return *this;
+    }
+
+    /*!
+     * \brief bitwise xor with rhs
+     *
+     * \throw std::invalid_argument if the sizes differ
+     */
+    auto operator^=(runtime_bitarray const& rhs) -> runtime_bitarray&
+    {
+        combine(rhs, [](word_type const a, word_type const b) { return a ^ b; });
+        return *this;
+    }
+
+    /*!
+     * \brief clear the bits set in rhs, i.e. *this & ~rhs
+     *
+     * \throw std::invalid_argument if the sizes differ
+     */
+    auto subtract(runtime_bitarray const& rhs) -> runtime_bitarray&
+    {
+        combine(rhs, [](word_type const a, word_type const b) { return a & ~b; });
+        return *this;
+    }
+
+    /// get copy with all bits inverted
+    [[nodiscard]] auto operator~() const -> runtime_bitarray
+    {
+        auto result = *this;
+        result.flip();
+        return result;
+    }
+
+    /// get the underlying storage
+    [[nodiscard]] auto container() const noexcept -> container_type const&
+    {
+        return m_words;
+    }
+
+    /// swap with another runtime_bitarray
+    void swap(runtime_bitarray& rhs) noexcept
+    {
+        m_words.swap(rhs.m_words);
+        std::swap(m_size, rhs.m_size);
+    }
+
+  private:
+    /// number of words for n bits
+    static constexpr auto words_for(size_type const n) noexcept -> size_type
+    {
+        return n / bits_per_word + ((n % bits_per_word == 0) ? 0 : 1);
+    }
+
+    /// mask of bit pos in its word
+    static constexpr auto mask(size_type const pos) noexcept -> word_type
+    {
+        return word_type{1} << (pos % bits_per_word);
+    }
+
+    /// set the bits of the last word beyond size() to 0
+    void clear_unused_bits() noexcept
+    {
+        if (auto const used = m_size % bits_per_word; used not_eq 0)
+        {
+            m_words.back() &= (word_type{1} << used) - 1;
+        }
+    }
+
+    /// get position of the first set bit at or after first, or npos
+    auto find_from(size_type const first) const noexcept -> size_type
+    {
+        if (first >= size())
+        {
+            return npos;
+        }
+
+        auto w = first / bits_per_word;
+        auto word = m_words[w] & (~word_type{0} << (first % bits_per_word));
+        while (word == 0)
+        {
+            if (++w == word_count())
+            {
+                return npos;
+            }
+            word = m_words[w];
+        }
+        return w * bits_per_word + detail::lowest_set_bit(word);
+    }
+
+    /// replace each word by op(word, word of rhs)
+    template <typename Op>
+    void combine(runtime_bitarray const& rhs, Op op)
+    {
+        if (size() not_eq rhs.size())
+        {
+            throw std::invalid_argument{"runtime_bitarray: sizes differ"};
+        }
+
+        auto const words = data();
+        auto const other = rhs.data();
+        for (auto w = size_type{0}; w < word_count(); ++w)
+        {
+            words[w] = op(words[w], other[w]);
+        }
+    }
+
+    /// the words
+    container_type m_words{};
+
+    /// number of bits
+    size_type m_size{0};
+};
+
+/// compare whether equal
+template <typename Allocator>
+bool operator==(runtime_bitarray<Allocator> const& lhs, runtime_bitarray<Allocator> const& rhs)
+{
+    return lhs.size() == rhs.size() and lhs.container() == rhs.container();
+}
+
+/// compare whether not equal
+template <typename Allocator>
+bool operator!=(runtime_bitarray<Allocator> const& lhs, runtime_bitarray<Allocator> const& rhs)
+{
+    return not (lhs == rhs);
+}
+
+/// bitwise and of lhs and rhs
+template <typename Allocator>
+[[nodiscard]] auto operator&(runtime_bitarray<Allocator> lhs, runtime_bitarray<Allocator> const& rhs) -> runtime_bitarray<Allocator>
+{
+    lhs &= rhs;
+    return lhs;
+}
+
+/// bitwise or of lhs and rhs
+template <typename Allocator>
+[[nodiscard]] auto operator|(runtime_bitarray<Allocator> lhs, runtime_bitarray<Allocator> const& rhs) -> runtime_bitarray<Allocator>
+{
+    lhs |= rhs;
+    return lhs;
+}
+
+/// bitwise xor of lhs and rhs
+template <typename Allocator>
+[[nodiscard]] auto operator^(runtime_bitarray<Allocator> lhs, runtime_bitarray<Allocator> const& rhs) -> runtime_bitarray<Allocator>
+{
+    lhs ^= rhs;
+    return lhs;
+}
+
+/// swap two runtime_bitarrays
+template <typename Allocator>
+void swap(runtime_bitarray<Allocator>& lhs, runtime_bitarray<Allocator>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/// runtime_bitarray is trivially relocatable, if its words are
+template <typename Allocator>
+struct is_trivially_relocatable<runtime_bitarray<Allocator>>
+    : is_trivially_relocatable<runtime_array<std::uint64_t, Allocator>>
+{
+};
+
+} // namespace bosswestfalen
+
+#endif
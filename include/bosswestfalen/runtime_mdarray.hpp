@@ -0,0 +1,365 @@
+/*!
+ * \file runtime_mdarray.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_RUNTIME_MDARRAY_HPP_
+#define BOSSWESTFALEN_RUNTIME_MDARRAY_HPP_
+
+
+#include "bosswestfalen/mdspan.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace bosswestfalen
+{
+/*!
+ * \brief Fixed size multi-dimensional array, that can be created at runtime.
+ *
+ * The elements are stored in a runtime_array, laid out by Layout. Elements
+ * are accessed with one index per dimension, view() and submdspan() give
+ * non-owning views without copying.
+ *
+ * \code
+ * auto image = runtime_array2d<float>(rows, cols);
+ * image(y, x) = 1.0f;
+ * auto const top_left = submdspan(image.view(), std::pair{0, rows / 2}, std::pair{0, cols / 2});
+ * \endcode
+ *
+ * \tparam T type of stored elements
+ * \tparam Extents extents of the dimensions, see extents and dextents
+ * \tparam Layout layout_right (row-major), layout_left (column-major) or any
+ *         layout whose mapping can be created from extents
+ * \tparam Allocator allocator of the underlying runtime_array
+ *
+ * \note A moved-from runtime_mdarray keeps its extents but has no elements,
+ *       it may only be assigned to or destroyed.
+ */
+template <typename T, typename Extents, typename Layout = layout_right, typename Allocator = std::allocator<T>>
+class runtime_mdarray final
+{
+  public:
+    /// type of the underlying storage
+    using container_type = runtime_array<T, Allocator>;
+
+    /// type of extents
+    using extents_type = Extents;
+
+    /// the layout
+    using layout_type = Layout;
+
+    /// maps indices to offsets
+    using mapping_type = typename Layout::template mapping<Extents>;
+
+    /// size type
+    using size_type = typename container_type::size_type;
+
+    /// type of dimension indices
+    using rank_type = typename Extents::rank_type;
+
+    /// alias for T
+    using value_type = T;
+
+    /// alias for Allocator
+    using allocator_type = Allocator;
+
+    /// alias for T&
+    using reference = T&;
+
+    /// alias for T const&
+    using const_reference = T const&;
+
+    /// alias for T*
+    using pointer = T*;
+
+    /// alias for T const*
+    using const_pointer = T const*;
+
+    /// view on the elements
+    using view_type = mdspan<T, Extents, Layout>;
+
+    /// read-only view on the elements
+    using const_view_type = mdspan<T const, Extents, Layout>;
+
+    /// number of dimensions
+    [[nodiscard]] static constexpr auto rank() noexcept -> rank_type
+    {
+        return extents_type::rank();
+    }
+
+    /// number of dimensions with dynamic extent
+    [[nodiscard]] static constexpr auto rank_dynamic() noexcept -> rank_type
+    {
+        return extents_type::rank_dynamic();
+    }
+
+    /// compile time extent of dimension r, or dynamic_extent
+    [[nodiscard]] static constexpr auto static_extent(rank_type const r) noexcept -> size_type
+    {
+        return extents_type::static_extent(r);
+    }
+
+    /// create with the static extents, dynamic extents are 0
+    runtime_mdarray()
+        : runtime_mdarray(mapping_type{})
+    {
+    }
+
+    /// create with the dynamic extents, or all extents, given; elements are default-initialised
+    template <typename... Sizes,
+              typename = std::enable_if_t<(sizeof...(Sizes) > 0)
+                                          and (sizeof...(Sizes) == rank_dynamic() or sizeof...(Sizes) == rank())
+                                          and (... and std::is_convertible_v<Sizes, size_type>)>>
+    explicit runtime_mdarray(Sizes const... sizes)
+        : runtime_mdarray(mapping_type{extents_type(static_cast<size_type>(sizes)...)})
+    {
+    }
+
+    /*!
+     * \brief create with given mapping (or extents), elements are default-initialised
+     *
+     * \param m the mapping
+     * \param alloc allocator to use
+     */
+    explicit runtime_mdarray(mapping_type const& m, allocator_type const& alloc = allocator_type{})
+        : m_mapping{m}
+        , m_container(m.required_span_size(), alloc)
+    {
+    }
+
+    /*!
+     * \brief create with given mapping (or extents), elements will be overwritten
+     *
+     * \param m the mapping
+     * \param alloc allocator to use
+     * \see runtime_array(size_type, for_overwrite_t, allocator_type const&)
+     */
+    runtime_mdarray(mapping_type const& m, for_overwrite_t, allocator_type const& alloc = allocator_type{})
+        : m_mapping{m}
+        , m_container(m.required_span_size(), for_overwrite, alloc)
+    {
+    }
+
+    /*!
+     * \brief create with given mapping (or extents), elements are value-initialised
+     *
+     * \param m the mapping
+     * \param alloc allocator to use
+     * \see runtime_array(size_type, value_initialise_t, allocator_type const&)
+     */
+    runtime_mdarray(mapping_type const& m, value_initialise_t, allocator_type const& alloc = allocator_type{})
+        : m_mapping{m}
+        , m_container(m.required_span_size(), value_initialise, alloc)
+    {
+    }
+
+    /*!
+     * \brief create with given mapping (or extents) and initialise with value
+     *
+     * \param m the mapping
+     * \param value value used to initialise elements
+     * \param alloc allocator to use
+     */
+    runtime_mdarray(mapping_type const& m, const_reference value, allocator_type const& alloc = allocator_type{})
+        : m_mapping{m}
+        , m_container(m.required_span_size(), value, alloc)
+    {
+    }
+
+    /*!
+     * \brief take over the elements of a flat runtime_array
+     *
+     * \param m the mapping
+     * \param container elements, laid out according to m
+     * \throw std::length_error if container has less than m.required_span_size() elements
+     */
+    runtime_mdarray(mapping_type const& m, container_type&& container)
+        : m_mapping{m}
+        , m_container{std::move(container)}
+    {
+        if (m_container.size() < m_mapping.required_span_size())
+        {
+            container = std::move(m_container);
+            throw std::length_error{"runtime_mdarray: container is too small for the extents"};
+        }
+    }
+
+    /// get element (indices...), no bounds checking is performed
+    template <typename... Indices>
+    [[nodiscard]] auto operator()(Indices const... indices) const -> const_reference
+    {
+        return m_container[m_mapping(indices...)];
+    }
+
+    /// \copydoc operator()(Indices const...) const
+    template <typename... Indices>
+    [[nodiscard]] auto operator()(Indices const... indices) -> reference
+    {
+        return m_container[m_mapping(indices...)];
+    }
+
+    /*!
+     * \brief get element (indices...) with bounds checking
+     *
+     * \throw std::out_of_range if an index is not less than its extent
+     */
+    template <typename... Indices>
+    [[nodiscard]] auto at(Indices const... indices) const -> const_reference
+    {
+        return view().at(indices...);
+    }
+
+    /// \copydoc at(Indices const...) const
+    template <typename... Indices>
+    [[nodiscard]] auto at(Indices const... indices) -> reference
+    {
+        return view().at(indices...);
+    }
+
+    /// get extents
+    [[nodiscard]] auto extents() const noexcept -> extents_type const&
+    {
+        return m_mapping.extents();
+    }
+
+    /// get extent of dimension r
+    [[nodiscard]] auto extent(rank_type const r) const noexcept -> size_type
+    {
+        return extents().extent(r);
+    }
+
+    /// get number of elements
+    [[nodiscard]] auto size() const noexcept -> size_type
+    {
+        return extents().product(0, rank());
+    }
+
+    /// check for emptiness
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /// get distance between neighbours in dimension r
+    [[nodiscard]] auto stride(rank_type const r) const noexcept -> size_type
+    {
+        return m_mapping.stride(r);
+    }
+
+    /// get mapping
+    [[nodiscard]] auto mapping() const noexcept -> mapping_type const&
+    {
+        return m_mapping;
+    }
+
+    /// get pointer to the underlying storage
+    [[nodiscard]] auto data() const noexcept -> const_pointer
+    {
+        return m_container.data();
+    }
+
+    /// \copydoc data() const
+    [[nodiscard]] auto data() noexcept -> pointer
+    {
+        return m_container.data();
+    }
+
+    /// get the underlying storage
+    [[nodiscard]] auto container() const noexcept -> container_type const&
+    {
+        return m_container;
+    }
+
+    /// give up the underlying storage, *this is empty afterwards
+    [[nodiscard]] auto extract_container() && noexcept -> container_type
+    {
+        m_mapping = mapping_type{};
+        return std::move(m_container);
+    }
+
+    /// get read-only view on the elements
+    [[nodiscard]] auto view() const noexcept -> const_view_type
+    {
+        return const_view_type{data(), m_mapping};
+    }
+
+    /// get view on the elements
+    [[nodiscard]] auto view() noexcept -> view_type
+    {
+        return view_type{data(), m_mapping};
+    }
+
+    /// \copydoc view() const
+    operator const_view_type() const noexcept
+    {
+        return view();
+    }
+
+    /// \copydoc view()
+    operator view_type() noexcept
+    {
+        return view();
+    }
+
+    /// swap with another runtime_mdarray
+    void swap(runtime_mdarray& rhs) noexcept
+    {
+        std::swap(m_mapping, rhs.m_mapping);
+        m_container.swap(rhs.m_container);
+    }
+
+  private:
+    /// maps indices to offsets
+    mapping_type m_mapping;
+
+    /// the elements
+    container_type m_container;
+};
+
+/// arrays are equal, if they have the same extents and equal underlying storage
+template <typename T, typename Extents, typename Layout, typename Allocator>
+bool operator==(runtime_mdarray<T, Extents, Layout, Allocator> const& lhs,
+                runtime_mdarray<T, Extents, Layout, Allocator> const& rhs)
+{
+    return lhs.mapping() == rhs.mapping() and lhs.container() == rhs.container();
+}
+
+/// arrays are equal, if they have the same extents and equal underlying storage
+template <typename T, typename Extents, typename Layout, typename Allocator>
+bool operator!=(runtime_mdarray<T, Extents, Layout, Allocator> const& lhs,
+                runtime_mdarray<T, Extents, Layout, Allocator> const& rhs)
+{
+    return not (lhs == rhs);
+}
+
+/// swap two runtime_mdarrays
+template <typename T, typename Extents, typename Layout, typename Allocator>
+void swap(runtime_mdarray<T, Extents, Layout, Allocator>& lhs, runtime_mdarray<T, Extents, Layout, Allocator>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+
+/// matrix or image with both extents known at runtime
+template <typename T, typename Layout = layout_right, typename Allocator = std::allocator<T>>
+using runtime_array2d = runtime_mdarray<T, dextents<2>, Layout, Allocator>;
+
+/// array of Rank dimensions, all extents known at runtime
+template <typename T, std::size_t Rank, typename Layout = layout_right, typename Allocator = std::allocator<T>>
+using runtime_arraynd = runtime_mdarray<T, dextents<Rank>, Layout, Allocator>;
+
+} // namespace bosswestfalen
+
+#endif
@@ -0,0 +1,763 @@
+/*!
+ * \file runtime_soa.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_RUNTIME_SOA_HPP_
+#define BOSSWESTFALEN_RUNTIME_SOA_HPP_
+
+
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+
+namespace bosswestfalen
+{
+/*!
+ * \brief non-owning view on one column of a runtime_soa
+ *
+ * \tparam T type of the elements, const for read-only access
+ */
+template <typename T>
+class soa_column final
+{
+  public:
+    /// type of the elements
+    using value_type = std::remove_cv_t<T>;
+
+    /// size type
+    using size_type = std::size_t;
+
+    /// reference to an element
+    using reference = T&;
+
+    /// pointer to an element
+    using pointer = T*;
+
+    /// iterator
+    using iterator = T*;
+
+    /// empty column
+    constexpr soa_column() noexcept = default;
+
+    /// view on n elements starting at data
+    constexpr soa_column(T* const data, size_type const n) noexcept
+        : m_data{data}
+        , m_size{n}
+    {
+    }
+
+    /// read-only view on a mutable column
+    template <typename U, typename = std::enable_if_t<std::is_same_v<T, U const>>>
+    constexpr soa_column(soa_column<U> const& other) noexcept
+        : m_data{other.data()}
+        , m_size{other.size()}
+    {
+    }
+
+    /// get pointer to the first element
+    [[nodiscard]] constexpr auto data() const noexcept -> pointer
+    {
+        return m_data;
+    }
+
+    /// get number of elements
+    [[nodiscard]] constexpr auto size() const noexcept -> size_type
+    {
+        return m_size;
+    }
+
+    /// check for emptiness
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool
+    {
+        return m_size == 0;
+    }
+
+    /// get element at pos, no bounds checking is performed
+    [[nodiscard]] constexpr auto operator[](size_type const pos) const -> reference
+    {
+        return m_data[pos];
+    }
+
+    /// get iterator to first element
+    [[nodiscard]] constexpr auto begin() const noexcept -> iterator
+    {
+        return m_data;
+    }
+
+    /// get iterator to one-past-last element
+    [[nodiscard]] constexpr auto end() const noexcept -> iterator
+    {
+        return m_data + m_size;
+    }
+
+  private:
+    /// first element
+    T* m_data{nullptr};
+
+    /// number of elements
+    size_type m_size{0};
+};
+
+
+/*!
+ * \brief Fixed size structure of arrays, that can be created at runtime.
+ *
+ * A row consists of one element of each of Ts. Each field is stored as its
+ * own contiguous column, all columns share one allocation. Scans over some
+ * fields only load the cache lines of these fields.
+ *
+ * Every column starts at a multiple of alignment. Rows are accessed via
+ * proxy references, i.e. std::tuple<Ts&...>.
+ *
+ * \tparam Ts types of the fields
+ */
+template <typename... Ts>
+class runtime_soa final
+{
+    static_assert(sizeof...(Ts) > 0, "runtime_soa needs at least one field");
+    static_assert((... and (std::is_object_v<Ts> and not std::is_const_v<Ts>)), "fields must be non-const objects");
+
+    /// row iterator, Const for read-only access
+    template <bool Const>
+    class row_iterator;
+
+  public:
+    /// number of fields
+    static constexpr std::size_t columns = sizeof...(Ts);
+
+    /// alignment of each column, at least a cache line
+    static constexpr std::size_t alignment = std::max({std::size_t{64}, alignof(Ts)...});
+
+    /// type of the I-th field
+    template <std::size_t I>
+    using column_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    /// size type
+    using size_type = std::size_t;
+
+    /// difference type
+    using difference_type = std::ptrdiff_t;
+
+    /// a row by value
+    using value_type = std::tuple<Ts...>;
+
+    /// proxy reference to a row
+    using reference = std::tuple<Ts&...>;
+
+    /// proxy reference to a constant row
+    using const_reference = std::tuple<Ts const&...>;
+
+    /// iterator over rows
+    using iterator = row_iterator<false>;
+
+    /// constant iterator over rows
+    using const_iterator = row_iterator<true>;
+
+    /// create empty soa
+    runtime_soa() noexcept = default;
+
+    /// create soa with n default-initialised rows
+    explicit runtime_soa(size_type const n)
+        : runtime_soa(n, allocate_tag{})
+    {
+        initialise([](auto, auto* const p, size_type const i) { ::new (static_cast<void*>(p + i)) std::remove_pointer_t<decltype(p)>; });
+    }
+
+    /// create soa with n rows equal to value
+    runtime_soa(size_type const n, value_type const& value)
+        : runtime_soa(n, allocate_tag{})
+    {
+        initialise([&value](auto column, auto* const p, size_type const i)
+                   {
+                       ::new (static_cast<void*>(p + i)) column_type<decltype(column)::value>(std::get<decltype(column)::value>(value));
+                   });
+    }
+
+    /// create soa with the given rows
+    runtime_soa(std::initializer_list<value_type> const il)
+        : runtime_soa(il.size(), allocate_tag{})
+    {
+        initialise([&il](auto column, auto* const p, size_type const i)
+                   {
+                       ::new (static_cast<void*>(p + i)) column_type<decltype(column)::value>(std::get<decltype(column)::value>(il.begin()[i]));
+                   });
+    }
+
+    /// destroy rows and release memory
+    ~runtime_soa()
+    {
+        destroy(m_size, std::index_sequence_for<Ts...>{});
+        deallocate();
+    }
+
+    /// copy construct, trivially copyable columns are copied with memcpy
+    runtime_soa(runtime_soa const& orig)
+        : runtime_soa(orig.size(), allocate_tag{})
+    {
+        initialise([&orig](auto column, auto* const p, size_type const i)
+                   {
+                       ::new (static_cast<void*>(p + i)) column_type<decltype(column)::value>(orig.template column<decltype(column)::value>()[i]);
+                   },
+                   &orig);
+    }
+
+    /// move construct, orig will be empty
+    runtime_soa(runtime_soa&& orig) noexcept
+        : m_size{std::exchange(orig.m_size, 0)}
+        , m_columns{std::exchange(orig.m_columns, {})}
+    {
+    }
+
+    /// copy assign
+    runtime_soa& operator=(runtime_soa const& rhs)
+    {
+        if (this not_eq std::addressof(rhs))
+        {
+            auto tmp = rhs;
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    /// move assign
+    runtime_soa& operator=(runtime_soa&& rhs) noexcept
+    {
+        auto tmp = runtime_soa{std::move(rhs)};
+        swap(tmp);
+        return *this;
+    }
+
+    /// swap with another runtime_soa
+    void swap(runtime_soa& rhs) noexcept
+    {
+        std::swap(m_size, rhs.m_size);
+        std::swap(m_columns, rhs.m_columns);
+    }
+
+    /// check for emptiness
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /// get number of rows
+    [[nodiscard]] auto size() const noexcept -> size_type
+    {
+        return m_size;
+    }
+
+    /// get pointer to the first element of the I-th column
+    template <std::size_t I>
+    [[nodiscard]] auto data() const noexcept -> column_type<I> const*
+    {
+#if defined(__GNUC__)
+        return static_cast<column_type<I> const*>(__builtin_assume_aligned(std::get<I>(m_columns), alignment));
+#else
+        return std::get<I>(m_columns);
+#endif
+    }
+
+    /// \copydoc data()
+    template <std::size_t I>
+    [[nodiscard]] auto data() noexcept -> column_type<I>*
+    {
+        return const_cast<column_type<I>*>(std::as_const(*this).template data<I>());
+    }
+
+    /// get view on the I-th column
+    template <std::size_t I>
+    [[nodiscard]] auto column() const noexcept -> soa_column<column_type<I> const>
+    {
+        return {data<I>(), size()};
+    }
+
+    /// \copydoc column()
+    template <std::size_t I>
+    [[nodiscard]] auto column() noexcept -> soa_column<column_type<I>>
+    {
+        return {data<I>(), size()};
+    }
+
+    /*!
+     * \brief get proxy reference to specified row
+     *
+     * \note No bounds checking is performed.
+     *
+     * \param pos position of the row
+     * \return tuple of references to the fields of the row
+     */
+    [[nodiscard]] auto operator[](size_type const pos) const -> const_reference
+    {
+        return row<const_reference>(pos, std::index_sequence_for<Ts...>{});
+    }
+
+    /// \copydoc operator[]
+    [[nodiscard]] auto operator[](size_type const pos) -> reference
+    {
+        return row<reference>(pos, std::index_sequence_for<Ts...>{});
+    }
+
+    /*!
+     * \brief get proxy reference to specified row
+     *
+     * \note Bounds checking is performed.
+     *
+     * \param pos position of the row
+     * \return tuple of references to the fields of the row
+     */
+    [[nodiscard]] auto at(size_type const pos) const -> const_reference
+    {
+        if (size() <= pos)
+        {
+            throw std::out_of_range{""};
+        }
+        return operator[](pos);
+    }
+
+    /// \copydoc at
+    [[nodiscard]] auto at(size_type const pos) -> reference
+    {
+        if (size() <= pos)
+        {
+            throw std::out_of_range{""};
+        }
+        return operator[](pos);
+    }
+
+    /// get iterator to first row
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator
+    {
+        return const_iterator{this, 0};
+    }
+
+    /// \copydoc cbegin()
+    [[nodiscard]] auto begin() const noexcept -> const_iterator
+    {
+        return cbegin();
+    }
+
+    /// \copydoc cbegin()
+    [[nodiscard]] auto begin() noexcept -> iterator
+    {
+        return iterator{this, 0};
+    }
+
+    /// get iterator to one-past-last row
+    [[nodiscard]] auto cend() const noexcept -> const_iterator
+    {
+        return const_iterator{this, size()};
+    }
+
+    /// \copydoc cend()
+    [[nodiscard]] auto end() const noexcept -> const_iterator
+    {
+        return cend();
+    }
+
+    /// \copydoc cend()
+    [[nodiscard]] auto end() noexcept -> iterator
+    {
+        return iterator{this, size()};
+    }
+
+    /// assign given row to all rows, column by column
+    void fill(value_type const& value)
+    {
+        fill(value, std::index_sequence_for<Ts...>{});
+    }
+
+  private:
+    /// tag for the ctor that only allocates
+    struct allocate_tag
+    {
+    };
+
+    /// allocate memory for n rows, the rows are not constructed
+    runtime_soa(size_type const n, allocate_tag)
+        : m_size{n}
+    {
+        if (n == 0)
+        {
+            return;
+        }
+
+        auto const offsets = layout(n);
+        auto const memory = static_cast<std::byte*>(::operator new(offsets.back(), std::align_val_t{alignment}));
+        place(memory, offsets, std::index_sequence_for<Ts...>{});
+    }
+
+    /*!
+     * \brief offsets of the columns for n rows
+     *
+     * \return offset of each column, followed by the total size in bytes
+     * \throw std::bad_array_new_length if n rows do not fit into memory
+     */
+    static auto layout(size_type const n) -> std::array<std::size_t, columns + 1>
+    {
+        constexpr auto row_size = (... + sizeof(Ts));
+        if (n > (std::numeric_limits<std::size_t>::max() - columns * alignment) / row_size)
+        {
+            throw std::bad_array_new_length{};
+        }
+
+        auto offsets = std::array<std::size_t, columns + 1>{};
+        auto offset = std::size_t{0};
+        auto c = std::size_t{0};
+        for (auto const element_size : {sizeof(Ts)...})
+        {
+            offsets[c++] = offset;
+            offset = (offset + n * element_size + alignment - 1) / alignment * alignment;
+        }
+        offsets[columns] = offset;
+        return offsets;
+    }
+
+    /// set the column pointers into memory
+    template <std::size_t... I>
+    void place(std::byte* const memory, std::array<std::size_t, columns + 1> const& offsets, std::index_sequence<I...>) noexcept
+    {
+        ((std::get<I>(m_columns) = reinterpret_cast<column_type<I>*>(memory + offsets[I])), ...);
+    }
+
+    /// release the memory, the rows must be destroyed already
+    void deallocate() noexcept
+    {
+        if (std::get<0>(m_columns) not_eq nullptr)
+        {
+            ::operator delete(static_cast<void*>(std::get<0>(m_columns)), std::align_val_t{alignment});
+        }
+    }
+
+    /*!
+     * \brief construct all rows, column by column, by calling init(column, pointer, index)
+     *
+     * column is a std::integral_constant holding the index of the column.
+     * Columns of trivially copyable types are copied with memcpy from orig,
+     * if given. If init throws, all elements constructed so far are destroyed
+     * and the memory is released before the exception is rethrown, leaving
+     * the soa empty for the destructor of the delegating ctor.
+     */
+    template <typename Init>
+    void initialise(Init&& init, runtime_soa const* const orig = nullptr)
+    {
+        auto constructed = std::array<size_type, columns>{};
+        try
+        {
+            initialise(init, orig, constructed, std::index_sequence_for<Ts...>{});
+        }
+        catch (...)
+        {
+            destroy(constructed, std::index_sequence_for<Ts...>{});
+            deallocate();
+            m_size = 0;
+            m_columns = {};
+            throw;
+        }
+    }
+
+    /// \copydoc initialise
+    template <typename Init, std::size_t... I>
+    void initialise(Init& init, runtime_soa const* const orig, std::array<size_type, columns>& constructed,
+                    std::index_sequence<I...>)
+    {
+        (initialise_column<I>(init, orig, constructed[I]), ...);
+    }
+
+    /// construct the elements of column I
+    template <std::size_t I, typename Init>
+    void initialise_column(Init& init, runtime_soa const* const orig, size_type& constructed)
+    {
+        auto const p = data<I>();
+        if constexpr (std::is_trivially_copyable_v<column_type<I>>)
+        {
+            if (orig not_eq nullptr)
+            {
+                if (m_size not_eq 0)
+                {
+                    std::memcpy(p, orig->template data<I>(), m_size * sizeof(column_type<I>));
+                }
+                constructed = m_size;
+                return;
+            }
+        }
+
+        for (; constructed < m_size; ++constructed)
+        {
+            init(std::integral_constant<std::size_t, I>{}, p, constructed);
+        }
+    }
+
+    /// destroy the first n elements of every column
+    template <std::size_t... I>
+    void destroy(size_type const n, std::index_sequence<I...>) noexcept
+    {
+        (std::destroy_n(std::get<I>(m_columns), n), ...);
+    }
+
+    /// destroy the first constructed[I] elements of column I
+    template <std::size_t... I>
+    void destroy(std::array<size_type, columns> const& constructed, std::index_sequence<I...>) noexcept
+    {
+        (std::destroy_n(std::get<I>(m_columns), constructed[I]), ...);
+    }
+
+    /// tuple of references to the fields of row pos
+    template <typename Reference, std::size_t... I>
+    auto row(size_type const pos, std::index_sequence<I...>) const -> Reference
+    {
+        return Reference{std::get<I>(m_columns)[pos]...};
+    }
+
+    /// assign the fields of value to their columns
+    template <std::size_t... I>
+    void fill(value_type const& value, std::index_sequence<I...>)
+    {
+        (std::fill_n(data<I>(), size(), std::get<I>(value)), ...);
+    }
+
+    /// number of rows
+    size_type m_size{0};
+
+    /// first element of each column
+    std::tuple<Ts*...> m_columns{};
+};
+
+
+/*!
+ * \brief iterator over the rows of a runtime_soa
+ *
+ * Dereferencing yields a proxy reference, i.e. a tuple of references. It
+ * supports all random access operations, but a forward iterator needs a real
+ * reference, so it is categorised as an input iterator. Algorithms that swap
+ * through iterators, e.g. std::sort, do not work with it.
+ */
+template <typename... Ts>
+template <bool Const>
+class runtime_soa<Ts...>::row_iterator final
+{
+    /// the iterated soa
+    using owner = std::conditional_t<Const, runtime_soa const, runtime_soa>;
+
+  public:
+    /// iterator category
+    using iterator_category = std::input_iterator_tag;
+
+    /// a row by value
+    using value_type = runtime_soa::value_type;
+
+    /// difference type
+    using difference_type = std::ptrdiff_t;
+
+    /// proxy reference to a row
+    using reference = std::conditional_t<Const, runtime_soa::const_reference, runtime_soa::reference>;
+
+    /// no pointer to a proxy
+    using pointer = void;
+
+    /// singular iterator
+    row_iterator() noexcept = default;
+
+    /// iterator to row pos of soa
+    row_iterator(owner* const soa, size_type const pos) noexcept
+        : m_owner{soa}
+        , m_pos{pos}
+    {
+    }
+
+    /// constant iterator from iterator
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    row_iterator(row_iterator<false> const& other) noexcept
+        : m_owner{other.m_owner}
+        , m_pos{other.m_pos}
+    {
+    }
+
+    /// get the current row
+    [[nodiscard]] auto operator*() const -> reference
+    {
+        return (*m_owner)[m_pos];
+    }
+
+    /// get row n after the current one
+    [[nodiscard]] auto operator[](difference_type const n) const -> reference
+    {
+        return (*m_owner)[m_pos + static_cast<size_type>(n)];
+    }
+
+    /// pre-increment
+    auto operator++() noexcept -> row_iterator&
+    {
+        ++m_pos;
+        return *this;
+    }
+
+    /// post-increment
+    auto operator++(int) noexcept -> row_iterator
+    {
+        auto const old = *this;
+        ++m_pos;
+        return old;
+    }
+
+    /// pre-decrement
+    auto operator--() noexcept -> row_iterator&
+    {
+        --m_pos;
+        return *this;
+    }
+
+    /// post-decrement
+    auto operator--(int) noexcept -> row_iterator
+    {
+        auto const old = *this;
+        --m_pos;
+        return old;
+    }
+
+    /// advance by n rows
+    auto operator+=(difference_type const n) noexcept -> row_iterator&
+    {
+        m_pos = static_cast<size_type>(static_cast<difference_type>(m_pos) + n);
+        return *this;
+    }
+
+    /// go back by n rows
+    auto operator-=(difference_type const n) noexcept -> row_iterator&
+    {
+        return *this += -n;
+    }
+
+    /// iterator n rows after it
+    [[nodiscard]] friend auto operator+(row_iterator it, difference_type const n) noexcept -> row_iterator
+    {
+        return it += n;
+    }
+
+    /// \copydoc operator+(row_iterator, difference_type)
+    [[nodiscard]] friend auto operator+(difference_type const n, row_iterator it) noexcept -> row_iterator
+    {
+        return it += n;
+    }
+
+    /// iterator n rows before it
+    [[nodiscard]] friend auto operator-(row_iterator it, difference_type const n) noexcept -> row_iterator
+    {
+        return it -= n;
+    }
+
+    /// distance between two iterators
+    [[nodiscard]] friend auto operator-(row_iterator const& lhs, row_iterator const& rhs) noexcept -> difference_type
+    {
+        return static_cast<difference_type>(lhs.m_pos) - static_cast<difference_type>(rhs.m_pos);
+    }
+
+    /// compare whether equal
+    [[nodiscard]] friend bool operator==(row_iterator const& lhs, row_iterator const& rhs) noexcept
+    {
+        return lhs.m_pos == rhs.m_pos;
+    }
+
+    /// compare whether not equal
+    [[nodiscard]] friend bool operator!=(row_iterator const& lhs, row_iterator const& rhs) noexcept
+    {
+        return lhs.m_pos not_eq rhs.m_pos;
+    }
+
+    /// check whether lhs is before rhs
+    [[nodiscard]] friend bool operator<(row_iterator const& lhs, row_iterator const& rhs) noexcept
+    {
+        return lhs.m_pos < rhs.m_pos;
+    }
+
+    /// check whether lhs is after rhs
+    [[nodiscard]] friend bool operator>(row_iterator const& lhs, row_iterator const& rhs) noexcept
+    {
+        return rhs < lhs;
+    }
+
+    /// check whether lhs is not after rhs
+    [[nodiscard]] friend bool operator<=(row_iterator const& lhs, row_iterator const& rhs) noexcept
+    {
+        return not (rhs < lhs);
+    }
+
+    /// check whether lhs is not before rhs
+    [[nodiscard]] friend bool operator>=(row_iterator const& lhs, row_iterator const& rhs) noexcept
+    {
+        return not (lhs < rhs);
+    }
+
+  private:
+    /// the constant iterator copies the state
+    friend class row_iterator<true>;
+
+    /// the iterated soa
+    owner* m_owner{nullptr};
+
+    /// current row
+    size_type m_pos{0};
+};
+
+
+namespace detail
+{
+/// compare the columns of two equally sized runtime_soas
+template <typename... Ts, std::size_t... I>
+bool equal_columns(runtime_soa<Ts...> const& lhs, runtime_soa<Ts...> const& rhs, std::index_sequence<I...>)
+{
+    return (... and std::equal(lhs.template data<I>(), lhs.template data<I>() + lhs.size(), rhs.template data<I>()));
+}
+} // namespace detail
+
+/// compare whether equal, column by column
+template <typename... Ts>
+bool operator==(runtime_soa<Ts...> const& lhs, runtime_soa<Ts...> const& rhs)
+{
+    if (lhs.size() not_eq rhs.size())
+    {
+        return false;
+    }
+
+    return detail::equal_columns(lhs, rhs, std::index_sequence_for<Ts...>{});
+}
+
+/// compare whether not equal
+template <typename... Ts>
+bool operator!=(runtime_soa<Ts...> const& lhs, runtime_soa<Ts...> const& rhs)
+{
+    return not (lhs == rhs);
+}
+
+/// free function swap, same as runtime_soa::swap
+template <typename... Ts>
+void swap(runtime_soa<Ts...>& lhs, runtime_soa<Ts...>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/// runtime_soa only holds pointers into its memory
+template <typename... Ts>
+struct is_trivially_relocatable<runtime_soa<Ts...>> : std::true_type
+{
+};
+
+} // namespace bosswestfalen
+
+#endif
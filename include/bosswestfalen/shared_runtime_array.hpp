@@ -0,0 +1,598 @@
+/*!
+ * \file shared_runtime_array.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_SHARED_RUNTIME_ARRAY_HPP_
+#define BOSSWESTFALEN_SHARED_RUNTIME_ARRAY_HPP_
+
+
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace bosswestfalen
+{
+namespace detail
+{
+/// header in front of the elements of a shared_runtime_array
+template <typename A>
+struct shared_header final : allocator_holder<A>
+{
+    /// store allocator, there is one reference
+    shared_header(A const& alloc, std::size_t const n) noexcept
+        : allocator_holder<A>{alloc}
+        , size{n}
+    {
+    }
+
+    /// number of shared_runtime_arrays referring to this block
+    std::atomic<std::size_t> references{1};
+
+    /// number of elements
+    std::size_t size;
+};
+} // namespace detail
+
+
+/*!
+ * \brief Immutable fixed size array, whose elements are shared by all copies.
+ *
+ * The reference count, the size and the allocator are stored in a header
+ * in the same allocation as the elements. So creating needs a single
+ * allocation, and a copy is one atomic increment: no allocation, no
+ * copying of elements, and the elements are only one pointer away.
+ *
+ * The elements cannot be modified. A runtime_array is turned into a
+ * shared_runtime_array by freeze().
+ *
+ * \code
+ * auto const table = freeze(std::move(array));
+ * for (auto& worker : workers)
+ * {
+ *     worker = std::thread{[table] { use(table); }};
+ * }
+ * \endcode
+ *
+ * \tparam T type of stored elements
+ * \tparam Allocator allocator used for the elements, its value_type must be T;
+ *         the memory is allocated with a rebound copy of it
+ *
+ * \note Copies may be used and destroyed concurrently by different threads,
+ *       like copies of std::shared_ptr.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class shared_runtime_array final
+{
+    /// traits of the used allocator
+    using allocator_traits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<T, typename allocator_traits::value_type>, "Allocator::value_type must be T");
+
+    /// the header
+    using header_type = detail::shared_header<Allocator>;
+
+    /// alignment of the allocation
+    static constexpr std::size_t alignment = std::max(alignof(header_type), alignof(T));
+
+    /// unit of the allocation, so header and elements are aligned
+    struct alignas(alignment) unit
+    {
+        /// raw memory
+        std::byte bytes[alignment];
+    };
+
+    /// allocator of the units
+    using unit_allocator = typename allocator_traits::template rebind_alloc<unit>;
+
+    /// distance between the header and the first element in bytes
+    static constexpr std::size_t element_offset = (sizeof(header_type) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+  public:
+    /// size type
+    using size_type = std::size_t;
+
+    /// difference type
+    using difference_type = std::ptrdiff_t;
+
+    /// alias for T
+    using value_type = T;
+
+    /// alias for Allocator
+    using allocator_type = Allocator;
+
+    /// alias for T const&, elements cannot be modified
+    using reference = T const&;
+
+    /// alias for T const&
+    using const_reference = T const&;
+
+    /// alias for T const*, elements cannot be modified
+    using pointer = T const*;
+
+    /// alias for T const*
+    using const_pointer = T const*;
+
+    /// iterator
+    using iterator = T const*;
+
+    /// const iterator
+    using const_iterator = T const*;
+
+    /// reverse iterator
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    /// const reverse iterator
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /// create empty array, no memory is allocated
+    shared_runtime_array() noexcept = default;
+
+    /*!
+     * \brief create with n value-initialised elements
+     *
+     * \param n number of elements
+     * \param alloc allocator to use
+     */
+    shared_runtime_array(size_type const n, value_initialise_t, allocator_type const& alloc = allocator_type{})
+        : m_header{create(n, alloc, [](allocator_type& a, T* const p, size_type) { allocator_traits::construct(a, p); })}
+    {
+    }
+
+    /*!
+     * \brief create with n elements, all equal to value
+     *
+     * \param n number of elements
+     * \param value value used to initialise elements
+     * \param alloc allocator to use
+     */
+    shared_runtime_array(size_type const n, const_reference value, allocator_type const& alloc = allocator_type{})
+        : m_header{create(n, alloc, [&value](allocator_type& a, T* const p, size_type) { allocator_traits::construct(a, p, value); })}
+    {
+    }
+
+    /*!
+     * \brief create with n elements, element i is initialised with f(i)
+     *
+     * \param n number of elements
+     * \param f function called once per element, in order
+     * \param alloc allocator to use
+     */
+    template <typename F, typename = std::enable_if_t<std::is_invocable_v<F&, size_type>>>
+    shared_runtime_array(size_type const n, generate_t, F f, allocator_type const& alloc = allocator_type{})
+        : m_header{create(n, alloc, [&f](allocator_type& a, T* const p, size_type const i) { allocator_traits::construct(a, p, f(i)); })}
+    {
+    }
+
+    /*!
+     * \brief create with the given elements
+     *
+     * \param il elements to copy
+     * \param alloc allocator to use
+     */
+    shared_runtime_array(std::initializer_list<value_type> const il, allocator_type const& alloc = allocator_type{})
+        : m_header{copy(il.begin(), il.size(), alloc)}
+    {
+    }
+
+    /// copy the elements of a runtime_array
+    explicit shared_runtime_array(runtime_array<T, Allocator> const& array)
+        : m_header{copy(array.data(), array.size(), array.get_allocator())}
+    {
+    }
+
+    /*!
+     * \brief move the elements of a runtime_array, which is empty afterwards
+     *
+     * Trivially copyable elements are copied with memcpy, others are moved.
+     *
+     * \see freeze()
+     */
+    explicit shared_runtime_array(runtime_array<T, Allocator>&& array)
+        : m_header{take(std::move(array))}
+    {
+    }
+
+    /// share the elements of orig, one atomic increment
+    shared_runtime_array(shared_runtime_array const& orig) noexcept
+        : m_header{orig.m_header}
+    {
+        if (m_header not_eq nullptr)
+        {
+            m_header->references.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// take over the elements of orig, orig is empty afterwards
+    shared_runtime_array(shared_runtime_array&& orig) noexcept
+        : m_header{std::exchange(orig.m_header, nullptr)}
+    {
+    }
+
+    /// share the elements of rhs
+    shared_runtime_array& operator=(shared_runtime_array const& rhs) noexcept
+    {
+        shared_runtime_array{rhs}.swap(*this);
+        return *this;
+    }
+
+    /// take over the elements of rhs, rhs is empty afterwards
+    shared_runtime_array& operator=(shared_runtime_array&& rhs) noexcept
+    {
+        shared_runtime_array{std::move(rhs)}.swap(*this);
+        return *this;
+    }
+
+    /// drop the reference, the last one destroys the elements and releases the memory
+    ~shared_runtime_array()
+    {
+        if (m_header not_eq nullptr and m_header->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            destroy(m_header, m_header->size);
+        }
+    }
+
+    /// get the allocator, a default constructed one if empty
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type
+    {
+        return (m_header == nullptr) ? allocator_type{} : m_header->allocator();
+    }
+
+    /// get number of shared_runtime_arrays sharing the elements, 0 if empty
+    [[nodiscard]] auto use_count() const noexcept -> size_type
+    {
+        return (m_header == nullptr) ? 0 : m_header->references.load(std::memory_order_relaxed);
+    }
+
+    /// check for emptiness
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /// get number of elements
+    [[nodiscard]] auto size() const noexcept -> size_type
+    {
+        return (m_header == nullptr) ? 0 : m_header->size;
+    }
+
+    /// get pointer to the first element, nullptr if empty
+    [[nodiscard]] auto data() const noexcept -> const_pointer
+    {
+        return (m_header == nullptr) ? nullptr : elements(m_header);
+    }
+
+    /// get element at pos, no bounds checking is performed
+    [[nodiscard]] auto operator[](size_type const pos) const noexcept -> const_reference
+    {
+        return elements(m_header)[pos];
+    }
+
+    /*!
+     * \brief get element at pos with bounds checking
+     *
+     * \throw std::out_of_range if pos is not less than size()
+     */
+    [[nodiscard]] auto at(size_type const pos) const -> const_reference
+    {
+        if (size() <= pos)
+        {
+            throw std::out_of_range{""};
+        }
+        return operator[](pos);
+    }
+
+    /// get first element, the array must not be empty
+    [[nodiscard]] auto front() const noexcept -> const_reference
+    {
+        return operator[](0);
+    }
+
+    /// get last element, the array must not be empty
+    [[nodiscard]] auto back() const noexcept -> const_reference
+    {
+        return operator[](size() - 1);
+    }
+
+    /// get iterator to the first element
+    [[nodiscard]] auto begin() const noexcept -> const_iterator
+    {
+        return data();
+    }
+
+    /// get iterator past the last element
+    [[nodiscard]] auto end() const noexcept -> const_iterator
+    {
+        return data() + size();
+    }
+
+    /// \copydoc begin()
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator
+    {
+        return begin();
+    }
+
+    /// \copydoc end()
+    [[nodiscard]] auto cend() const noexcept -> const_iterator
+    {
+        return end();
+    }
+
+    /// get reverse iterator to the last element
+    [[nodiscard]] auto rbegin() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{end()};
+    }
+
+    /// get reverse iterator before the first element
+    [[nodiscard]] auto rend() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{begin()};
+    }
+
+    /// \copydoc rbegin()
+    [[nodiscard]] auto crbegin() const noexcept -> const_reverse_iterator
+    {
+        return rbegin();
+    }
+
+    /// \copydoc rend()
+    [[nodiscard]] auto crend() const noexcept -> const_reverse_iterator
+    {
+        return rend();
+    }
+
+    /// check whether both share the same elements
+    [[nodiscard]] auto shares_with(shared_runtime_array const& other) const noexcept -> bool
+    {
+        return m_header == other.m_header;
+    }
+
+    /*!
+     * \brief compare lexicographically in a single pass
+     *
+     * Shared elements are only skipped, if they are bytewise equal types.
+     *
+     * \return -1 if *this is less than other, 1 if it is greater, 0 otherwise
+     * \see runtime_array::compare()
+     */
+    [[nodiscard]] auto compare(shared_runtime_array const& other) const -> int
+    {
+        if constexpr (detail::is_bytewise_equal<T>)
+        {
+            if (shares_with(other))
+            {
+                return 0;
+            }
+        }
+        return detail::lexicographical_order(data(), size(), other.data(), other.size());
+    }
+
+    /// swap with another shared_runtime_array
+    void swap(shared_runtime_array& rhs) noexcept
+    {
+        std::swap(m_header, rhs.m_header);
+    }
+
+  private:
+    /// trivially copyable elements are copied by copying their bytes
+    static constexpr bool copies_bytes = std::is_trivially_copyable_v<value_type>
+                                         and not (detail::has_construct_impl<void, allocator_type, T*, value_type const&>::value
+                                                  and not detail::is_std_allocator<allocator_type>::value);
+
+    /// get pointer to the first element behind header
+    static auto elements(header_type* const header) noexcept -> T*
+    {
+        return reinterpret_cast<T*>(reinterpret_cast<std::byte*>(header) + element_offset);
+    }
+
+    /*!
+     * \brief number of units for header and n elements
+     *
+     * \throw std::bad_array_new_length if n elements do not fit into memory
+     */
+    static auto units_for(size_type const n) -> size_type
+    {
+        if (n > (std::numeric_limits<size_type>::max() - element_offset - alignment) / sizeof(T))
+        {
+            throw std::bad_array_new_length{};
+        }
+        return (element_offset + n * sizeof(T) + alignment - 1) / alignment;
+    }
+
+    /*!
+     * \brief allocate a block for n elements and construct the elements by calling init(allocator, pointer, index)
+     *
+     * No memory is requested for n == 0. If init throws, all elements
+     * constructed so far are destroyed and the memory is released before the
+     * exception is rethrown.
+     *
+     * \return the header of the block, nullptr for n == 0
+     */
+    template <typename Init>
+    static auto create(size_type const n, allocator_type const& alloc, Init&& init) -> header_type*
+    {
+        if (n == 0)
+        {
+            return nullptr;
+        }
+
+        auto units = unit_allocator{alloc};
+        auto const count = units_for(n);
+        auto const block = std::allocator_traits<unit_allocator>::allocate(units, count);
+        auto const header = ::new (static_cast<void*>(block)) header_type{alloc, n};
+        auto const first = elements(header);
+
+        auto i = size_type{0};
+        try
+        {
+            for (; i < n; ++i)
+            {
+                init(header->allocator(), first + i, i);
+            }
+        }
+        catch (...)
+        {
+            destroy(header, i);
+            throw;
+        }
+        return header;
+    }
+
+    /// allocate a block and copy n elements from source
+    static auto copy(T const* const source, size_type const n, allocator_type const& alloc) -> header_type*
+    {
+        if constexpr (copies_bytes)
+        {
+            auto const header = create(n, alloc, [](allocator_type&, T*, size_type) noexcept {});
+            if (header not_eq nullptr)
+            {
+                std::memcpy(static_cast<void*>(elements(header)), static_cast<void const*>(source), n * sizeof(T));
+            }
+            return header;
+        }
+        else
+        {
+            return create(n, alloc, [source](allocator_type& a, T* const p, size_type const i) { allocator_traits::construct(a, p, source[i]); });
+        }
+    }
+
+    /// allocate a block and move the elements of array, which is empty afterwards
+    static auto take(runtime_array<T, Allocator>&& array) -> header_type*
+    {
+        auto source = std::move(array);
+        if constexpr (copies_bytes)
+        {
+            return copy(source.data(), source.size(), source.get_allocator());
+        }
+        else
+        {
+            auto const elements = source.data();
+            return create(source.size(), source.get_allocator(), [elements](allocator_type& a, T* const p, size_type const i) {
+                allocator_traits::construct(a, p, std::move_if_noexcept(elements[i]));
+            });
+        }
+    }
+
+    /// destroy the first n elements and the header, and release the memory
+    static void destroy(header_type* const header, size_type const n) noexcept
+    {
+        auto alloc = std::move(header->allocator());
+        if constexpr (not std::is_trivially_destructible_v<value_type> or detail::has_destroy<allocator_type, value_type>)
+        {
+            auto const first = elements(header);
+            for (auto i = size_type{0}; i < n; ++i)
+            {
+                allocator_traits::destroy(alloc, first + i);
+            }
+        }
+        auto const count = (element_offset + header->size * sizeof(T) + alignment - 1) / alignment;
+        header->~header_type();
+
+        auto units = unit_allocator{alloc};
+        std::allocator_traits<unit_allocator>::deallocate(units, reinterpret_cast<unit*>(header), count);
+    }
+
+    /// header of the shared block, nullptr if empty
+    header_type* m_header{nullptr};
+};
+
+/*!
+ * \brief turn a runtime_array into an immutable shared_runtime_array
+ *
+ * \param array the elements, array is empty afterwards
+ * \return shared_runtime_array(std::move(array))
+ */
+template <typename T, typename Allocator>
+auto freeze(runtime_array<T, Allocator>&& array) -> shared_runtime_array<T, Allocator>
+{
+    return shared_runtime_array<T, Allocator>(std::move(array));
+}
+
+/*!
+ * \brief compare whether equal
+ *
+ * Arrays sharing their elements are equal without comparing them, if T is
+ * bytewise equal. Other types are compared like runtime_array, so an array
+ * containing NaN is not equal to itself.
+ */
+template <typename T, typename A>
+bool operator==(shared_runtime_array<T, A> const& lhs, shared_runtime_array<T, A> const& rhs)
+{
+    if constexpr (detail::is_bytewise_equal<T>)
+    {
+        if (lhs.shares_with(rhs))
+        {
+            return true;
+        }
+    }
+    return lhs.size() == rhs.size() and detail::first_mismatch(lhs.data(), rhs.data(), lhs.size()) == lhs.size();
+}
+
+/// compare whether not equal
+template <typename T, typename A>
+bool operator!=(shared_runtime_array<T, A> const& lhs, shared_runtime_array<T, A> const& rhs)
+{
+    return not (lhs == rhs);
+}
+
+/// check whether lhs < rhs, see shared_runtime_array::compare()
+template <typename T, typename A>
+bool operator<(shared_runtime_array<T, A> const& lhs, shared_runtime_array<T, A> const& rhs)
+{
+    return lhs.compare(rhs) < 0;
+}
+
+/// check whether lhs > rhs, see shared_runtime_array::compare()
+template <typename T, typename A>
+bool operator>(shared_runtime_array<T, A> const& lhs, shared_runtime_array<T, A> const& rhs)
+{
+    return lhs.compare(rhs) > 0;
+}
+
+/// check whether lhs <= rhs, see shared_runtime_array::compare()
+template <typename T, typename A>
+bool operator<=(shared_runtime_array<T, A> const& lhs, shared_runtime_array<T, A> const& rhs)
+{
+    return lhs.compare(rhs) <= 0;
+}
+
+/// check whether lhs >= rhs, see shared_runtime_array::compare()
+template <typename T, typename A>
+bool operator>=(shared_runtime_array<T, A> const& lhs, shared_runtime_array<T, A> const& rhs)
+{
+    return lhs.compare(rhs) >= 0;
+}
+
+/// free function swap, same as shared_runtime_array::swap
+template <typename T, typename A>
+void swap(shared_runtime_array<T, A>& lhs, shared_runtime_array<T, A>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+/// a shared_runtime_array is a single pointer, it can be relocated by copying it
+template <typename T, typename A>
+struct is_trivially_relocatable<shared_runtime_array<T, A>> : std::true_type
+{
+};
+
+} // namespace bosswestfalen
+
+#endif
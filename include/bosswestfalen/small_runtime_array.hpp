@@ -0,0 +1,686 @@
+/*!
+ * \file small_runtime_array.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_SMALL_RUNTIME_ARRAY_HPP_
+#define BOSSWESTFALEN_SMALL_RUNTIME_ARRAY_HPP_
+
+
+#include "bosswestfalen/runtime_array.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+namespace bosswestfalen
+{
+/*!
+ * \brief Fixed size array, that can be created at runtime and stores small arrays inline.
+ *
+ * Up to N elements are stored inside the object itself, only larger arrays
+ * obtain memory from the allocator. Apart from that, it behaves like
+ * runtime_array.
+ *
+ * Moving an array with heap storage only transfers the pointer. Inline
+ * elements are moved one by one, or copied with a single memcpy if T is
+ * trivially copyable.
+ *
+ * \tparam T Type of stored elements.
+ * \tparam N Maximal number of elements stored inline, must not be 0.
+ * \tparam Allocator Allocator used for more than N elements, its pointer type must be T*.
+ *
+ * \note data() of an empty small_runtime_array is not nullptr.
+ */
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>>
+class small_runtime_array final : private detail::allocator_holder<Allocator>
+{
+    /// base storing the allocator
+    using allocator_base = detail::allocator_holder<Allocator>;
+
+    /// traits of the used allocator
+    using allocator_traits = std::allocator_traits<Allocator>;
+
+    static_assert(N > 0, "use runtime_array for arrays without inline storage");
+    static_assert(std::is_same_v<T, typename allocator_traits::value_type>, "Allocator::value_type must be T");
+    static_assert(std::is_same_v<T*, typename allocator_traits::pointer>, "fancy pointers are not supported");
+
+  public:
+    /// size type
+    using size_type = std::size_t;
+
+    /// alias for T
+    using value_type = T;
+
+    /// alias for Allocator
+    using allocator_type = Allocator;
+
+    /// alias for T&
+    using reference = T&;
+
+    /// alias for T const&
+    using const_reference = T const&;
+
+    /// alias for T*
+    using pointer = T*;
+
+    /// alias for T const *;
+    using const_pointer = T const*;
+
+    /// alias for T*
+    using iterator = T*;
+
+    /// alias for T const*
+    using const_iterator = T const*;
+
+    /// alias for T* for reversed iteration
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    /// alias for T const* for reversed iteration
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    /// maximal number of elements stored inline
+    static constexpr size_type inline_capacity = N;
+
+    /*!
+     * \brief default ctor for empty array
+     *
+     * Create an empty small_runtime_array.
+     */
+    small_runtime_array() noexcept(std::is_nothrow_default_constructible_v<allocator_type>) = default;
+
+    /*!
+     * \brief create empty array using given allocator
+     *
+     * \param alloc allocator used for later assigned elements
+     */
+    explicit small_runtime_array(allocator_type const& alloc) noexcept
+        : allocator_base{alloc}
+    {
+    }
+
+    /*!
+     * \brief create with given size
+     *
+     * \param n number of elements
+     * \param alloc allocator to use
+     */
+    explicit small_runtime_array(size_type const n,
+                                 allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{allocate(m_size)}
+    {
+        initialise([this](pointer const p, size_type) { construct_at(p); });
+    }
+
+    /*!
+     * \brief create with given size and initialise with value
+     *
+     * \param n number of elements
+     * \param value value used to initialise elements
+     * \param alloc allocator to use
+     */
+    small_runtime_array(size_type const n,
+                        const_reference value,
+                        allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{allocate(m_size)}
+    {
+        initialise([this, &value](pointer const p, size_type) { construct_at(p, value); });
+    }
+
+    /*!
+     * \brief create array and fill with initializer list content
+     *
+     * \param il elements used to initialise
+     * \param alloc allocator to use
+     */
+    small_runtime_array(std::initializer_list<value_type> il,
+                        allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{il.size()}
+        , m_data{allocate(m_size)}
+    {
+        copy_from(il.begin());
+    }
+
+    /*!
+     * \brief create array and fill with pointed-to elements
+     *
+     * \param ptr pointer to source data
+     * \param n number of elements to copy
+     * \param alloc allocator to use
+     */
+    small_runtime_array(const_pointer ptr,
+                        size_type const n,
+                        allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{n}
+        , m_data{allocate(m_size)}
+    {
+        copy_from(ptr);
+    }
+
+    /*!
+     * \brief create array and fill with range
+     *
+     * \param begin iterator to first element
+     * \param end iterator to one-past-last element
+     * \param alloc allocator to use
+     *
+     * \tparam I iterator type, must be at least forward iterator
+     *
+     * \note if std::distance(begin, end) is negative, behaviour is undefined
+     */
+    template <typename I,
+              typename = std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<I>::iterator_category>, void*>>
+    small_runtime_array(I begin, I end,
+                        allocator_type const& alloc = allocator_type{})
+        : allocator_base{alloc}
+        , m_size{static_cast<size_type>(std::distance(begin, end))}
+        , m_data{allocate(m_size)}
+    {
+        copy_from(begin);
+    }
+
+    /// destroy objects and release memory
+    ~small_runtime_array()
+    {
+        destroy_n(m_data, m_size);
+        deallocate();
+    }
+
+    /// copy construct, allocator is obtained by select_on_container_copy_construction
+    small_runtime_array(small_runtime_array const& orig)
+        : small_runtime_array(orig, allocator_traits::select_on_container_copy_construction(orig.get_allocator()))
+    {
+    }
+
+    /// copy construct using given allocator
+    small_runtime_array(small_runtime_array const& orig, allocator_type const& alloc)
+        : allocator_base{alloc}
+        , m_size{orig.size()}
+        , m_data{allocate(m_size)}
+    {
+        if constexpr (std::is_trivially_copyable_v<value_type>)
+        {
+            if (is_inline())
+            {
+                std::memcpy(m_buffer, orig.m_buffer, sizeof(m_buffer));
+                return;
+            }
+        }
+        copy_from(orig.data());
+    }
+
+    /// move construct, orig will be empty
+    small_runtime_array(small_runtime_array&& orig) noexcept(std::is_nothrow_move_constructible_v<value_type>)
+        : allocator_base{std::move(orig.allocator())}
+    {
+        take(orig, true);
+    }
+
+    /*!
+     * \brief move construct using given allocator
+     *
+     * If orig uses heap storage and alloc compares equal to its allocator, the
+     * storage is taken over. Otherwise the elements are moved one by one.
+     * orig will be empty.
+     */
+    small_runtime_array(small_runtime_array&& orig, allocator_type const& alloc)
+        : allocator_base{alloc}
+    {
+        take(orig, allocator_traits::is_always_equal::value or get_allocator() == orig.get_allocator());
+    }
+
+    /// copy assign
+    small_runtime_array& operator=(small_runtime_array const& rhs)
+    {
+        if (this == std::addressof(rhs))
+        {
+            return *this;
+        }
+
+        constexpr auto propagate = allocator_traits::propagate_on_container_copy_assignment::value;
+        auto tmp = small_runtime_array(rhs, propagate ? rhs.get_allocator() : get_allocator());
+        clear();
+        if constexpr (propagate)
+        {
+            this->allocator() = tmp.allocator();
+        }
+        take(tmp, true);
+
+        return *this;
+    }
+
+    /// move assign
+    small_runtime_array& operator=(small_runtime_array&& rhs) noexcept(std::is_nothrow_move_constructible_v<value_type>
+                                                                      and (allocator_traits::propagate_on_container_move_assignment::value
+                                                                           or allocator_traits::is_always_equal::value))
+    {
+        if (this == std::addressof(rhs))
+        {
+            return *this;
+        }
+
+        clear();
+        if constexpr (allocator_traits::propagate_on_container_move_assignment::value)
+        {
+            this->allocator() = std::move(rhs.allocator());
+            take(rhs, true);
+        }
+        else
+        {
+            take(rhs, allocator_traits::is_always_equal::value or get_allocator() == rhs.get_allocator());
+        }
+
+        return *this;
+    }
+
+    /*!
+     * \brief swap with another small_runtime_array
+     *
+     * Heap storage is swapped by pointer, inline elements are moved.
+     *
+     * \note If the allocator does not propagate on swap, both allocators must compare equal.
+     */
+    void swap(small_runtime_array& rhs) noexcept(std::is_nothrow_move_constructible_v<value_type>)
+    {
+        if (this == std::addressof(rhs))
+        {
+            return;
+        }
+
+        if (not is_inline() and not rhs.is_inline())
+        {
+            if constexpr (allocator_traits::propagate_on_container_swap::value)
+            {
+                using std::swap;
+                swap(this->allocator(), rhs.allocator());
+            }
+            std::swap(m_size, rhs.m_size);
+            std::swap(m_data, rhs.m_data);
+            return;
+        }
+
+        auto tmp = small_runtime_array{std::move(rhs)};
+        rhs.take(*this, true);
+        take(tmp, true);
+        if constexpr (allocator_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(this->allocator(), rhs.allocator());
+        }
+    }
+
+    /// get a copy of the used allocator
+    [[nodiscard]] auto get_allocator() const noexcept -> allocator_type
+    {
+        return this->allocator();
+    }
+
+    /// check whether the elements are stored inline
+    [[nodiscard]] auto is_inline() const noexcept -> bool
+    {
+        return size() <= inline_capacity;
+    }
+
+    /// check for emptiness
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+        return size() == 0;
+    }
+
+    /// get number of elements
+    [[nodiscard]] auto size() const noexcept -> size_type
+    {
+        return m_size;
+    }
+
+    /// get direct access to the data
+    [[nodiscard]] auto data() const noexcept -> const_pointer
+    {
+        return m_data;
+    }
+
+    /// \copydoc data()
+    [[nodiscard]] auto data() noexcept -> pointer
+    {
+        return const_cast<pointer>(std::as_const(*this).data());
+    }
+
+    /*!
+     * \brief get reference to specified element
+     *
+     * Returns a reference to the element at specified position.
+     * \note No bounds checking is performed.
+     *
+     * \param pos position of the element
+     * \return reference of the element
+     */
+    [[nodiscard]] auto operator[](size_type const pos) const -> const_reference
+    {
+        return *(data() + pos);
+    }
+
+    /// \copydoc operator[]
+    [[nodiscard]] auto operator[](size_type const pos) -> reference
+    {
+        return const_cast<reference>(std::as_const(*this)[pos]);
+    }
+
+    /*!
+     * \brief get reference to specified element
+     *
+     * Returns a reference to the element at specified position.
+     * \note Bounds checking is performed.
+     *
+     * \param pos position of the element
+     * \return reference of the element
+     */
+    [[nodiscard]] auto at(size_type const pos) const -> const_reference
+    {
+        if (size() <= pos)
+        {
+            throw std::out_of_range{""};
+        }
+        return operator[](pos);
+    }
+
+    /// \copydoc at
+    [[nodiscard]] auto at(size_type const pos) -> reference
+    {
+        return const_cast<reference>(std::as_const(*this).at(pos));
+    }
+
+    /// get reference to the first element
+    [[nodiscard]] auto front() const -> const_reference
+    {
+        return operator[](0);
+    }
+
+    /// \copydoc front
+    [[nodiscard]] auto front() -> reference
+    {
+        return const_cast<reference>(std::as_const(*this).front());
+    }
+
+    /// get reference to the last element
+    [[nodiscard]] auto back() const -> const_reference
+    {
+        return operator[](size() - 1);
+    }
+
+    /// \copydoc back
+    [[nodiscard]] auto back() -> reference
+    {
+        return const_cast<reference>(std::as_const(*this).back());
+    }
+
+    /// get iterator to first element
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator
+    {
+        return data();
+    }
+
+    /// \copydoc cbegin()
+    [[nodiscard]] auto begin() const noexcept -> const_iterator
+    {
+        return cbegin();
+    }
+
+    /// \copydoc begin()
+    [[nodiscard]] auto begin() noexcept -> iterator
+    {
+        return const_cast<iterator>(std::as_const(*this).begin());
+    }
+
+    /// get iterator to the "element" following the last element
+    [[nodiscard]] auto cend() const noexcept -> const_iterator
+    {
+        return (data() + size());
+    }
+
+    /// \copydoc end()
+    [[nodiscard]] auto end() const noexcept -> const_iterator
+    {
+        return cend();
+    }
+
+    /// \copydoc end()
+    [[nodiscard]] auto end() noexcept -> iterator
+    {
+        return const_cast<iterator>(std::as_const(*this).end());
+    }
+
+    /// get reverse iterator to the last element
+    [[nodiscard]] auto crbegin() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{cend()};
+    }
+
+    /// \copydoc crbegin()
+    [[nodiscard]] auto rbegin() const noexcept -> const_reverse_iterator
+    {
+        return crbegin();
+    }
+
+    /// \copydoc rbegin()
+    [[nodiscard]] auto rbegin() noexcept -> reverse_iterator
+    {
+        return reverse_iterator{end()};
+    }
+
+    /// get reverse iterator to the "element" before the first element
+    [[nodiscard]] auto crend() const noexcept -> const_reverse_iterator
+    {
+        return const_reverse_iterator{cbegin()};
+    }
+
+    /// \copydoc rend()
+    [[nodiscard]] auto rend() const noexcept -> const_reverse_iterator
+    {
+        return crend();
+    }
+
+    /// \copydoc rend()
+    [[nodiscard]] auto rend() noexcept -> reverse_iterator
+    {
+        return reverse_iterator{begin()};
+    }
+
+    /// assign given value to all elements
+    void fill(value_type const& val)
+    {
+        std::fill_n(data(), size(), val);
+    }
+
+  private:
+    /// pointer to the inline storage
+    auto inline_data() noexcept -> pointer
+    {
+        return reinterpret_cast<pointer>(m_buffer);
+    }
+
+    /// get inline storage or memory for n elements from the allocator
+    auto allocate(size_type const n) -> pointer
+    {
+        return (n <= inline_capacity) ? inline_data() : allocator_traits::allocate(this->allocator(), n);
+    }
+
+    /// release the memory of the elements, if it was taken from the allocator
+    void deallocate() noexcept
+    {
+        if (not is_inline())
+        {
+            allocator_traits::deallocate(this->allocator(), m_data, m_size);
+        }
+    }
+
+    /// construct a single element at p
+    template <typename... Args>
+    void construct_at(pointer const p, Args&&... args)
+    {
+        if constexpr (sizeof...(Args) == 0 and not detail::has_default_construct<allocator_type, value_type>)
+        {
+            ::new (static_cast<void*>(p)) value_type;
+        }
+        else
+        {
+            allocator_traits::construct(this->allocator(), p, std::forward<Args>(args)...);
+        }
+    }
+
+    /// destroy n elements starting at first
+    void destroy_n(pointer const first, size_type const n) noexcept
+    {
+        if constexpr (not std::is_trivially_destructible_v<value_type> or detail::has_destroy<allocator_type, value_type>)
+        {
+            for (auto i = size_type{0}; i < n; ++i)
+            {
+                allocator_traits::destroy(this->allocator(), first + i);
+            }
+        }
+    }
+
+    /*!
+     * \brief construct all elements by calling init(pointer, index)
+     *
+     * If init throws, all elements constructed so far are destroyed, the
+     * memory is released and the array is left empty before the exception is
+     * rethrown.
+     */
+    template <typename Init>
+    void initialise(Init&& init)
+    {
+        auto i = size_type{0};
+        try
+        {
+            for (; i < m_size; ++i)
+            {
+                init(m_data + i, i);
+            }
+        }
+        catch (...)
+        {
+            destroy_n(m_data, i);
+            deallocate();
+            m_size = 0;
+            m_data = inline_data();
+            throw;
+        }
+    }
+
+    /// copy construct all elements from range starting at first
+    template <typename I>
+    void copy_from(I first)
+    {
+        initialise([this, &first](pointer const p, size_type)
+                   {
+                       construct_at(p, *first);
+                       ++first;
+                   });
+    }
+
+    /// destroy all elements and release memory, array will be empty
+    void clear() noexcept
+    {
+        destroy_n(m_data, m_size);
+        deallocate();
+        m_size = 0;
+        m_data = inline_data();
+    }
+
+    /*!
+     * \brief take the elements of orig, this has to be empty
+     *
+     * Heap storage is taken over if steal is true, otherwise, and for inline
+     * elements, the elements are moved. orig will be empty.
+     */
+    void take(small_runtime_array& orig, bool const steal)
+    {
+        if (not orig.is_inline() and steal)
+        {
+            m_size = orig.m_size;
+            m_data = orig.m_data;
+            orig.m_size = 0;
+            orig.m_data = orig.inline_data();
+            return;
+        }
+
+        m_data = allocate(orig.size());
+        m_size = orig.size();
+        if constexpr (std::is_trivially_copyable_v<value_type>)
+        {
+            if (is_inline())
+            {
+                std::memcpy(m_buffer, orig.m_buffer, sizeof(m_buffer));
+                orig.m_size = 0;
+                return;
+            }
+        }
+        initialise([this, &orig](pointer const p, size_type const i) { construct_at(p, std::move(orig[i])); });
+        orig.clear();
+    }
+
+    /// number of elements
+    size_type m_size{0};
+
+    /// the elements, either the inline storage or memory from the allocator
+    pointer m_data{inline_data()};
+
+    /// inline storage
+    alignas(value_type) std::byte m_buffer[inline_capacity * sizeof(value_type)];
+};
+
+
+/// compare whether equal
+template <typename T, std::size_t N, typename A>
+bool operator==(small_runtime_array<T, N, A> const& lhs, small_runtime_array<T, N, A> const& rhs)
+{
+    if (lhs.size() not_eq rhs.size())
+    {
+        return false;
+    }
+
+    return std::equal(lhs.cbegin(), lhs.cend(), rhs.cbegin());
+}
+
+/// compare whether not equal
+template <typename T, std::size_t N, typename A>
+bool operator!=(small_runtime_array<T, N, A> const& lhs, small_runtime_array<T, N, A> const& rhs)
+{
+    return not (lhs == rhs);
+}
+
+/// check whether lhs < rhs
+template <typename T, std::size_t N, typename A>
+bool operator<(small_runtime_array<T, N, A> const& lhs, small_runtime_array<T, N, A> const& rhs)
+{
+    return std::lexicographical_compare(lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend());
+}
+
+
+/// free function swap, same as small_runtime_array::swap
+template <typename T, std::size_t N, typename A>
+void swap(small_runtime_array<T, N, A>& lhs, small_runtime_array<T, N, A>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+} // namespace bosswestfalen
+
+#endif
@@ -0,0 +1,625 @@
+/*!
+ * \file tiled_layouts.hpp
+ * \author Bosswestfalen (https://github.com/Bosswestfalen)
+ * \version 0.6.1
+ * \date 2019
+ * \copyright MIT License
+ */
+
+
+#ifndef BOSSWESTFALEN_TILED_LAYOUTS_HPP_
+#define BOSSWESTFALEN_TILED_LAYOUTS_HPP_
+
+
+#include "bosswestfalen/mdspan.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__BMI2__) and __has_include(<immintrin.h>)
+#include <immintrin.h>
+#define BOSSWESTFALEN_HAS_PDEP 1
+#else
+#define BOSSWESTFALEN_HAS_PDEP 0
+#endif
+
+
+namespace bosswestfalen
+{
+namespace detail
+{
+/// check whether n is a power of two
+constexpr bool is_power_of_two(std::size_t const n) noexcept
+{
+    return n not_eq 0 and (n & (n - 1)) == 0;
+}
+
+/// smallest k with 2^k >= n
+constexpr auto ceil_log2(std::size_t const n) noexcept -> std::size_t
+{
+    auto k = std::size_t{0};
+    while ((std::size_t{1} << k) < n)
+    {
+        ++k;
+    }
+    return k;
+}
+
+/// move bit b of x to bit 2b
+inline auto spread_bits(std::uint64_t const x) noexcept -> std::uint64_t
+{
+#if BOSSWESTFALEN_HAS_PDEP
+    return _pdep_u64(x, 0x5555555555555555);
+#else
+    auto v = x & 0x00000000ffffffff;
+    v = (v | (v << 16)) & 0x0000ffff0000ffff;
+    v = (v | (v << 8)) & 0x00ff00ff00ff00ff;
+    v = (v | (v << 4)) & 0x0f0f0f0f0f0f0f0f;
+    v = (v | (v << 2)) & 0x3333333333333333;
+    v = (v | (v << 1)) & 0x5555555555555555;
+    return v;
+#endif
+}
+} // namespace detail
+
+
+/*!
+ * \brief 2-d layout of row-major tiles, stored one after the other
+ *
+ * The matrix is split into tiles of TileRows x TileCols elements. Each tile
+ * is contiguous and row-major, tiles are ordered row-major as well. Edge
+ * tiles are padded, so the mapped memory may be larger than the matrix.
+ *
+ * Work on one tile stays within TileRows * TileCols elements, e.g. 16 KiB
+ * for 64 x 64 floats, independent of the extents of the matrix.
+ *
+ * \tparam TileRows rows per tile, a power of two
+ * \tparam TileCols columns per tile, a power of two
+ */
+template <std::size_t TileRows, std::size_t TileCols>
+struct layout_tiled
+{
+    static_assert(detail::is_power_of_two(TileRows) and detail::is_power_of_two(TileCols),
+                  "tile extents must be powers of two");
+
+    /// rows per tile
+    static constexpr std::size_t tile_rows = TileRows;
+
+    /// columns per tile
+    static constexpr std::size_t tile_cols = TileCols;
+
+    /// elements per tile
+    static constexpr std::size_t tile_size = TileRows * TileCols;
+
+    /// maps indices to offsets
+    template <typename Extents>
+    class mapping final
+    {
+        static_assert(Extents::rank() == 2, "layout_tiled is a 2-d layout");
+
+      public:
+        /// type of extents
+        using extents_type = Extents;
+
+        /// size type
+        using size_type = typename Extents::size_type;
+
+        /// type of dimension indices
+        using rank_type = typename Extents::rank_type;
+
+        /// the layout
+        using layout_type = layout_tiled;
+
+        /// mapping of empty extents
+        constexpr mapping() noexcept = default;
+
+        /// mapping of given extents
+        constexpr mapping(extents_type const& e) noexcept
+            : m_extents{e}
+            , m_tiles_per_row{(e.extent(1) + TileCols - 1) / TileCols}
+        {
+        }
+
+        /// convert from mapping of convertible extents
+        template <typename OtherExtents, typename = std::enable_if_t<std::is_convertible_v<OtherExtents, extents_type>>>
+        constexpr mapping(mapping<OtherExtents> const& other) noexcept
+            : mapping(extents_type{other.extents()})
+        {
+        }
+
+        /// get extents
+        [[nodiscard]] constexpr auto extents() const noexcept -> extents_type const&
+        {
+            return m_extents;
+        }
+
+        /// get offset of element (i, j)
+        template <typename I, typename J>
+        [[nodiscard]] constexpr auto operator()(I const i, J const j) const noexcept -> size_type
+        {
+            auto const row = static_cast<size_type>(i);
+            auto const col = static_cast<size_type>(j);
+            return tile_offset(row / TileRows, col / TileCols) + (row % TileRows) * TileCols + col % TileCols;
+        }
+
+        /// get offset of the first element of tile (tile_row, tile_col)
+        [[nodiscard]] constexpr auto tile_offset(size_type const tile_row, size_type const tile_col) const noexcept -> size_type
+        {
+            return (tile_row * m_tiles_per_row + tile_col) * tile_size;
+        }
+
+        /// get number of elements the mapped memory must provide, including padding
+        [[nodiscard]] constexpr auto required_span_size() const noexcept -> size_type
+        {
+            return tile_offset((m_extents.extent(0) + TileRows - 1) / TileRows, 0);
+        }
+
+        /// every element has its own offset
+        [[nodiscard]] static constexpr auto is_always_unique() noexcept -> bool
+        {
+            return true;
+        }
+
+        /// edge tiles are padded
+        [[nodiscard]] static constexpr auto is_always_exhaustive() noexcept -> bool
+        {
+            return false;
+        }
+
+        /// offsets are no weighted sum of the indices
+        [[nodiscard]] static constexpr auto is_always_strided() noexcept -> bool
+        {
+            return false;
+        }
+
+        /// mappings are equal, if their extents are equal
+        friend constexpr bool operator==(mapping const& lhs, mapping const& rhs) noexcept
+        {
+            return lhs.extents() == rhs.extents();
+        }
+
+        /// mappings are equal, if their extents are equal
+        friend constexpr bool operator!=(mapping const& lhs, mapping const& rhs) noexcept
+        {
+            return not (lhs == rhs);
+        }
+
+      private:
+        /// the extents
+        extents_type m_extents{};
+
+        /// number of tiles per row of tiles
+        size_type m_tiles_per_row{0};
+    };
+};
+
+
+/*!
+ * \brief 2-d layout in Z-order (Morton order)
+ *
+ * The bits of the row and column index are interleaved, so every aligned
+ * 2^k x 2^k block is contiguous, for all k at once. Neighbours in either
+ * dimension are close in memory, which keeps naive loops over rows and
+ * columns alike, e.g. transposes, cache-friendly.
+ *
+ * Both extents are padded to powers of two. If they differ, the larger one
+ * is split into Morton-ordered squares stored one after the other.
+ * Index mapping costs a few shifts and masks, or one pdep per index with
+ * BMI2.
+ *
+ * \note Extents must be less than 2^32.
+ */
+struct layout_morton
+{
+    /// maps indices to offsets
+    template <typename Extents>
+    class mapping final
+    {
+        static_assert(Extents::rank() == 2, "layout_morton is a 2-d layout");
+
+      public:
+        /// type of extents
+        using extents_type = Extents;
+
+        /// size type
+        using size_type = typename Extents::size_type;
+
+        /// type of dimension indices
+        using rank_type = typename Extents::rank_type;
+
+        /// the layout
+        using layout_type = layout_morton;
+
+        /// mapping of empty extents
+        constexpr mapping() noexcept = default;
+
+        /// mapping of given extents
+        constexpr mapping(extents_type const& e) noexcept
+            : m_extents{e}
+            , m_bits{std::min(detail::ceil_log2(e.extent(0)), detail::ceil_log2(e.extent(1)))}
+        {
+        }
+
+        /// convert from mapping of convertible extents
+        template <typename OtherExtents, typename = std::enable_if_t<std::is_convertible_v<OtherExtents, extents_type>>>
+        constexpr mapping(mapping<OtherExtents> const& other) noexcept
+            : mapping(extents_type{other.extents()})
+        {
+        }
+
+        /// get extents
+        [[nodiscard]] constexpr auto extents() const noexcept -> extents_type const&
+        {
+            return m_extents;
+        }
+
+        /// get offset of element (i, j)
+        template <typename I, typename J>
+        [[nodiscard]] auto operator()(I const i, J const j) const noexcept -> size_type
+        {
+            auto const row = static_cast<size_type>(i);
+            auto const col = static_cast<size_type>(j);
+            auto const low = (size_type{1} << m_bits) - 1;
+            auto const square = (row >> m_bits) + (col >> m_bits);
+            return (square << (2 * m_bits)) | (detail::spread_bits(row & low) << 1) | detail::spread_bits(col & low);
+        }
+
+        /// get number of elements the mapped memory must provide, including padding
+        [[nodiscard]] constexpr auto required_span_size() const noexcept -> size_type
+        {
+            if (m_extents.extent(0) == 0 or m_extents.extent(1) == 0)
+            {
+                return 0;
+            }
+            return (size_type{1} << detail::ceil_log2(m_extents.extent(0))) << detail::ceil_log2(m_extents.extent(1));
+        }
+
+        /// every element has its own offset
+        [[nodiscard]] static constexpr auto is_always_unique() noexcept -> bool
+        {
+            return true;
+        }
+
+        /// extents are padded
+        [[nodiscard]] static constexpr auto is_always_exhaustive() noexcept -> bool
+        {
+            return false;
+        }
+
+        /// offsets are no weighted sum of the indices
+        [[nodiscard]] static constexpr auto is_always_strided() noexcept -> bool
+        {
+            return false;
+        }
+
+        /// mappings are equal, if their extents are equal
+        friend constexpr bool operator==(mapping const& lhs, mapping const& rhs) noexcept
+        {
+            return lhs.extents() == rhs.extents();
+        }
+
+        /// mappings are equal, if their extents are equal
+        friend constexpr bool operator!=(mapping const& lhs, mapping const& rhs) noexcept
+        {
+            return not (lhs == rhs);
+        }
+
+      private:
+        /// the extents
+        extents_type m_extents{};
+
+        /// number of interleaved bits per index
+        size_type m_bits{0};
+    };
+};
+
+
+namespace detail
+{
+/// check whether L is a layout_tiled
+template <typename L>
+struct is_layout_tiled : std::false_type
+{
+};
+
+/// \copydoc is_layout_tiled
+template <std::size_t R, std::size_t C>
+struct is_layout_tiled<layout_tiled<R, C>> : std::true_type
+{
+};
+
+/// copy element (i, j) of src to (i, j) of dst, for all i and j
+template <typename Src, typename Dst>
+void copy_block(Src const& src, Dst const& dst)
+{
+    using src_value = std::remove_cv_t<typename Src::element_type>;
+    using dst_value = typename Dst::element_type;
+    constexpr auto contiguous_rows = Src::mapping_type::is_always_strided() and Dst::mapping_type::is_always_strided();
+
+    for (auto i = std::size_t{0}; i < src.extent(0); ++i)
+    {
+        if constexpr (contiguous_rows and std::is_same_v<src_value, dst_value> and std::is_trivially_copyable_v<dst_value>)
+        {
+            if (src.stride(1) == 1 and dst.stride(1) == 1)
+            {
+                std::copy_n(&src(i, 0), src.extent(1), &dst(i, 0));
+                continue;
+            }
+        }
+        for (auto j = std::size_t{0}; j < src.extent(1); ++j)
+        {
+            dst(i, j) = src(i, j);
+        }
+    }
+}
+} // namespace detail
+
+
+/// one tile of a matrix
+template <typename T>
+struct tile
+{
+    /// index of the first row of the tile in the matrix
+    std::size_t row;
+
+    /// index of the first column of the tile in the matrix
+    std::size_t col;
+
+    /// the elements, edge tiles may be smaller than the requested tile extents
+    mdspan<T, dextents<2>, layout_stride> view;
+};
+
+
+/*!
+ * \brief range over the tiles of a 2-d view, row of tiles by row of tiles
+ *
+ * Tiles of layout_tiled views with the same tile extents are contiguous.
+ * Tiles of strided views are created by submdspan.
+ *
+ * \tparam TileRows rows per tile
+ * \tparam TileCols columns per tile
+ * \tparam View type of the view, a 2-d mdspan
+ */
+template <std::size_t TileRows, std::size_t TileCols, typename View>
+class tile_range final
+{
+    static_assert(View::rank() == 2, "only 2-d views can be split into tiles");
+    static_assert(View::mapping_type::is_always_strided() or std::is_same_v<typename View::layout_type, layout_tiled<TileRows, TileCols>>,
+                  "tiles need a strided view or a layout_tiled view with the same tile extents");
+
+  public:
+    /// size type
+    using size_type = std::size_t;
+
+    /// a tile
+    using value_type = tile<typename View::element_type>;
+
+    /// input iterator over the tiles
+    class iterator final
+    {
+      public:
+        /// iterator category
+        using iterator_category = std::input_iterator_tag;
+
+        /// a tile
+        using value_type = tile_range::value_type;
+
+        /// difference type
+        using difference_type = std::ptrdiff_t;
+
+        /// tiles are created on access
+        using reference = value_type;
+
+        /// tiles are created on access
+        using pointer = void;
+
+        /// singular iterator
+        iterator() noexcept = default;
+
+        /// iterator to tile index of range
+        iterator(tile_range const* const range, size_type const index) noexcept
+            : m_range{range}
+            , m_index{index}
+        {
+        }
+
+        /// get the current tile
+        [[nodiscard]] auto operator*() const -> reference
+        {
+            return m_range->at(m_index);
+        }
+
+        /// go to next tile
+        auto operator++() noexcept -> iterator&
+        {
+            ++m_index;
+            return *this;
+        }
+
+        /// go to next tile
+        auto operator++(int) noexcept -> iterator
+        {
+            auto const old = *this;
+            ++m_index;
+            return old;
+        }
+
+        /// iterators are equal, if they point to the same tile
+        friend bool operator==(iterator const& lhs, iterator const& rhs) noexcept
+        {
+            return lhs.m_index == rhs.m_index;
+        }
+
+        /// iterators are equal, if they point to the same tile
+        friend bool operator!=(iterator const& lhs, iterator const& rhs) noexcept
+        {
+            return not (lhs == rhs);
+        }
+
+      private:
+        /// the range
+        tile_range const* m_range{nullptr};
+
+        /// index of the tile, row of tiles by row of tiles
+        size_type m_index{0};
+    };
+
+    /// tiles of view
+    explicit tile_range(View const& view) noexcept
+        : m_view{view}
+        , m_tiles_per_row{(view.extent(1) + TileCols - 1) / TileCols}
+        , m_tiles{(view.extent(0) + TileRows - 1) / TileRows * m_tiles_per_row}
+    {
+    }
+
+    /// get number of tiles
+    [[nodiscard]] auto size() const noexcept -> size_type
+    {
+        return m_tiles;
+    }
+
+    /// get number of tiles per row of tiles
+    [[nodiscard]] auto tiles_per_row() const noexcept -> size_type
+    {
+        return m_tiles_per_row;
+    }
+
+    /// get tile (tile_row, tile_col)
+    [[nodiscard]] auto operator()(size_type const tile_row, size_type const tile_col) const -> value_type
+    {
+        auto const row = tile_row * TileRows;
+        auto const col = tile_col * TileCols;
+        auto const rows = std::min(TileRows, m_view.extent(0) - row);
+        auto const cols = std::min(TileCols, m_view.extent(1) - col);
+
+        if constexpr (View::mapping_type::is_always_strided())
+        {
+            return value_type{row, col, submdspan(m_view, std::pair{row, row + rows}, std::pair{col, col + cols})};
+        }
+        else
+        {
+            using mapping_type = layout_stride::mapping<dextents<2>>;
+            auto const first = m_view.data() + m_view.mapping().tile_offset(tile_row, tile_col);
+            return value_type{row, col, {first, mapping_type{dextents<2>{rows, cols}, {TileCols, 1}}}};
+        }
+    }
+
+    /// get tile index, counted row of tiles by row of tiles
+    [[nodiscard]] auto at(size_type const index) const -> value_type
+    {
+        return operator()(index / m_tiles_per_row, index % m_tiles_per_row);
+    }
+
+    /// get iterator to the first tile
+    [[nodiscard]] auto begin() const noexcept -> iterator
+    {
+        return iterator{this, 0};
+    }
+
+    /// get iterator to one-past-last tile
+    [[nodiscard]] auto end() const noexcept -> iterator
+    {
+        return iterator{this, m_tiles};
+    }
+
+  private:
+    /// the split view
+    View m_view;
+
+    /// number of tiles per row of tiles
+    size_type m_tiles_per_row;
+
+    /// number of tiles
+    size_type m_tiles;
+};
+
+
+/*!
+ * \brief split a 2-d view into tiles of TileRows x TileCols elements
+ *
+ * \code
+ * for (auto const& [row, col, block] : tiles<64, 64>(image.view()))
+ * {
+ *     // block(i, j) is image(row + i, col + j)
+ * }
+ * \endcode
+ */
+template <std::size_t TileRows, std::size_t TileCols, typename T, typename Extents, typename Layout>
+[[nodiscard]] auto tiles(mdspan<T, Extents, Layout> const& view) noexcept
+{
+    return tile_range<TileRows, TileCols, mdspan<T, Extents, Layout>>{view};
+}
+
+/// split a layout_tiled view into its tiles
+template <typename T, typename Extents, std::size_t TileRows, std::size_t TileCols>
+[[nodiscard]] auto tiles(mdspan<T, Extents, layout_tiled<TileRows, TileCols>> const& view) noexcept
+{
+    return tiles<TileRows, TileCols>(view);
+}
+
+
+/*!
+ * \brief copy element (i, j) of src to element (i, j) of dst, converting between layouts
+ *
+ * Conversions between strided and tiled layouts go tile by tile, copying
+ * contiguous rows of a tile with memcpy where possible. All other
+ * conversions go block by block, so that neither side is accessed with
+ * large strides for long.
+ *
+ * \throw std::invalid_argument if the extents of src and dst differ
+ */
+template <typename T, typename SrcExtents, typename SrcLayout, typename U, typename DstExtents, typename DstLayout>
+void copy_elements(mdspan<T, SrcExtents, SrcLayout> const& src, mdspan<U, DstExtents, DstLayout> const& dst)
+{
+    using src_type = mdspan<T, SrcExtents, SrcLayout>;
+    using dst_type = mdspan<U, DstExtents, DstLayout>;
+    static_assert(src_type::rank() == 2 and dst_type::rank() == 2, "only 2-d views can be converted");
+
+    if (src.extents() not_eq dst.extents())
+    {
+        throw std::invalid_argument{"copy_elements: extents differ"};
+    }
+
+    if constexpr (detail::is_layout_tiled<DstLayout>::value and src_type::mapping_type::is_always_strided())
+    {
+        for (auto const& [row, col, block] : tiles(dst))
+        {
+            detail::copy_block(submdspan(src, std::pair{row, row + block.extent(0)}, std::pair{col, col + block.extent(1)}), block);
+        }
+    }
+    else if constexpr (detail::is_layout_tiled<SrcLayout>::value and dst_type::mapping_type::is_always_strided())
+    {
+        for (auto const& [row, col, block] : tiles(src))
+        {
+            detail::copy_block(block, submdspan(dst, std::pair{row, row + block.extent(0)}, std::pair{col, col + block.extent(1)}));
+        }
+    }
+    else
+    {
+        constexpr auto block = std::size_t{64};
+        for (auto row = std::size_t{0}; row < src.extent(0); row += block)
+        {
+            for (auto col = std::size_t{0}; col < src.extent(1); col += block)
+            {
+                auto const rows = std::min(block, src.extent(0) - row);
+                auto const cols = std::min(block, src.extent(1) - col);
+                for (auto i = row; i < row + rows; ++i)
+                {
+                    for (auto j = col; j < col + cols; ++j)
+                    {
+                        dst(i, j) = src(i, j);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace bosswestfalen
+
+#endif
@@ -0,0 +1,58 @@
+#include "bosswestfalen/aligned_allocator.hpp"
+#include "catch/catch.hpp"
+#include <cstdint>
+
+
+namespace
+{
+/// check whether p is aligned to alignment
+auto is_aligned(void const* const p, std::size_t const alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+
+/// type with large alignment
+struct alignas(32) wide
+{
+    char c;
+};
+} // namespace
+
+
+TEST_CASE("over-aligned storage", "[aligned]")
+{
+    SECTION("default alignment")
+    {
+        REQUIRE(bosswestfalen::runtime_array<int>::alignment == alignof(int));
+        REQUIRE(bosswestfalen::runtime_array<wide>::alignment == 32);
+    }
+
+    SECTION("alignment of the allocator")
+    {
+        using test_array = bosswestfalen::aligned_runtime_array<float>;
+        static_assert(test_array::alignment == bosswestfalen::cache_line_size);
+        static_assert(bosswestfalen::aligned_runtime_array<double, 128>::alignment == 128);
+
+        for (auto n = std::size_t{1}; n < 100; n += 7)
+        {
+            auto const rta = test_array(n, 1.0f);
+            REQUIRE(is_aligned(rta.data(), test_array::alignment));
+        }
+
+        auto const big = bosswestfalen::aligned_runtime_array<char, 4096>(10, 'x');
+        REQUIRE(is_aligned(big.data(), 4096));
+    }
+
+    SECTION("alignment is never smaller than alignof(T)")
+    {
+        REQUIRE(bosswestfalen::aligned_runtime_array<wide, 8>::alignment == 32);
+    }
+
+    SECTION("copies keep the alignment")
+    {
+        auto const src = bosswestfalen::aligned_runtime_array<float>{1.0f, 2.0f, 3.0f};
+        auto const copy = src;
+        REQUIRE(copy == src);
+        REQUIRE(is_aligned(copy.data(), 64));
+    }
+}
@@ -0,0 +1,253 @@
+#include "bosswestfalen/runtime_array.hpp"
+#include "catch/catch.hpp"
+#include <stdexcept>
+#include <vector>
+
+
+namespace
+{
+/// bookkeeping shared by all copies of a tracking_allocator
+struct allocation_log
+{
+    int allocations{0};
+    int deallocations{0};
+    int constructions{0};
+    int destructions{0};
+};
+
+/// stateful allocator that records its usage
+template <typename T, bool Propagate>
+struct tracking_allocator
+{
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_swap = std::bool_constant<Propagate>;
+
+    explicit tracking_allocator(allocation_log* l)
+        : log{l}
+    {
+    }
+
+    template <typename U>
+    tracking_allocator(tracking_allocator<U, Propagate> const& other)
+        : log{other.log}
+    {
+    }
+
+    T* allocate(std::size_t const n)
+    {
+        ++log->allocations;
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* const p, std::size_t const n)
+    {
+        ++log->deallocations;
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <typename... Args>
+    void construct(T* const p, Args&&... args)
+    {
+        ++log->constructions;
+        ::new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T* const p)
+    {
+        ++log->destructions;
+        p->~T();
+    }
+
+    friend bool operator==(tracking_allocator const& lhs, tracking_allocator const& rhs)
+    {
+        return lhs.log == rhs.log;
+    }
+
+    friend bool operator!=(tracking_allocator const& lhs, tracking_allocator const& rhs)
+    {
+        return not (lhs == rhs);
+    }
+
+    allocation_log* log;
+};
+
+/// element that throws on the n-th copy
+struct throwing_element
+{
+    static inline int copies_left{0};
+    static inline int alive{0};
+
+    throwing_element()
+    {
+        ++alive;
+    }
+
+    throwing_element(throwing_element const&)
+    {
+        if (copies_left-- == 0)
+        {
+            throw std::runtime_error{"copy"};
+        }
+        ++alive;
+    }
+
+    ~throwing_element()
+    {
+        --alive;
+    }
+};
+} // namespace
+
+
+TEST_CASE("allocator support", "[allocator]")
+{
+    SECTION("stateless allocator does not increase size")
+    {
+        REQUIRE(sizeof(bosswestfalen::runtime_array<int>) == 2 * sizeof(void*));
+    }
+
+    SECTION("elements are managed by the allocator")
+    {
+        using test_array = bosswestfalen::runtime_array<int, tracking_allocator<int, false>>;
+        auto log = allocation_log{};
+
+        {
+            auto const rta = test_array(3, 42, tracking_allocator<int, false>{&log});
+            REQUIRE(rta.get_allocator().log == &log);
+            REQUIRE(log.allocations == 1);
+            REQUIRE(log.constructions == 3);
+
+            auto const copy = rta;
+            REQUIRE(copy.get_allocator() == rta.get_allocator());
+            REQUIRE(log.allocations == 2);
+        }
+
+        REQUIRE(log.deallocations == 2);
+        REQUIRE(log.destructions == 6);
+    }
+
+    SECTION("no memory for empty arrays")
+    {
+        using test_array = bosswestfalen::runtime_array<int, tracking_allocator<int, false>>;
+        auto log = allocation_log{};
+        {
+            auto const rta = test_array(std::size_t{0}, tracking_allocator<int, false>{&log});
+            REQUIRE(rta.empty());
+            REQUIRE(rta.data() == nullptr);
+        }
+        REQUIRE(log.allocations == 0);
+        REQUIRE(log.deallocations == 0);
+    }
+
+    SECTION("allocator propagation")
+    {
+        auto log_a = allocation_log{};
+        auto log_b = allocation_log{};
+
+        SECTION("propagating allocator")
+        {
+            using alloc = tracking_allocator<int, true>;
+            using test_array = bosswestfalen::runtime_array<int, alloc>;
+            auto a = test_array({1, 2}, alloc{&log_a});
+            auto b = test_array({3}, alloc{&log_b});
+
+            SECTION("copy assign")
+            {
+                a = b;
+                REQUIRE(a.get_allocator().log == &log_b);
+                REQUIRE(a == b);
+            }
+
+            SECTION("copy assign equally sized arrays with unequal allocators")
+            {
+                auto c = test_array({4}, alloc{&log_a});
+                auto const data = c.data();
+                c = b;
+                REQUIRE(c.get_allocator().log == &log_b);
+                REQUIRE(c.data() not_eq data);
+                REQUIRE(c == b);
+            }
+
+            SECTION("move assign")
+            {
+                auto const data = b.data();
+                a = std::move(b);
+                REQUIRE(a.get_allocator().log == &log_b);
+                REQUIRE(a.data() == data);
+            }
+
+            SECTION("swap")
+            {
+                swap(a, b);
+                REQUIRE(a.get_allocator().log == &log_b);
+                REQUIRE(b.get_allocator().log == &log_a);
+            }
+        }
+
+        SECTION("non-propagating allocator")
+        {
+            using alloc = tracking_allocator<int, false>;
+            using test_array = bosswestfalen::runtime_array<int, alloc>;
+            auto a = test_array({1, 2}, alloc{&log_a});
+            auto b = test_array({3}, alloc{&log_b});
+
+            SECTION("copy assign")
+            {
+                a = b;
+                REQUIRE(a.get_allocator().log == &log_a);
+                REQUIRE(a == b);
+            }
+
+            SECTION("copy assign equally sized arrays reuses memory")
+            {
+                auto c = test_array({4}, alloc{&log_a});
+                auto const data = c.data();
+                auto const allocations = log_a.allocations;
+                c = b;
+                REQUIRE(c.get_allocator().log == &log_a);
+                REQUIRE(c.data() == data);
+                REQUIRE(log_a.allocations == allocations);
+                REQUIRE(c == b);
+            }
+
+            SECTION("move assign with unequal allocators moves elements")
+            {
+                auto const data = b.data();
+                a = std::move(b);
+                REQUIRE(a.get_allocator().log == &log_a);
+                REQUIRE(a.data() not_eq data);
+                REQUIRE(a == test_array({3}, alloc{&log_a}));
+            }
+
+            SECTION("move construct with equal allocator takes over elements")
+            {
+                auto const data = b.data();
+                auto const c = test_array(std::move(b), alloc{&log_b});
+                REQUIRE(c.data() == data);
+                REQUIRE(b.empty());
+            }
+        }
+
+        REQUIRE(log_a.allocations == log_a.deallocations);
+        REQUIRE(log_b.allocations == log_b.deallocations);
+        REQUIRE(log_a.constructions == log_a.destructions);
+        REQUIRE(log_b.constructions == log_b.destructions);
+    }
+
+    SECTION("exception during construction")
+    {
+        using alloc = tracking_allocator<throwing_element, false>;
+        using test_array = bosswestfalen::runtime_array<throwing_element, alloc>;
+        auto log = allocation_log{};
+        auto const src = std::vector<throwing_element>(4);
+
+        throwing_element::copies_left = 2;
+        REQUIRE_THROWS_AS(test_array(src.cbegin(), src.cend(), alloc{&log}), std::runtime_error);
+        REQUIRE(throwing_element::alive == 4);
+        REQUIRE(log.allocations == 1);
+        REQUIRE(log.deallocations == 1);
+        REQUIRE(log.destructions == 2);
+    }
+}
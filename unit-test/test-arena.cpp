@@ -0,0 +1,105 @@
+#include "bosswestfalen/runtime_array_arena.hpp"
+#include "catch/catch.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+using test_array = bosswestfalen::arena_runtime_array<int>;
+
+
+namespace
+{
+/// element counting its destructor calls
+struct counted
+{
+    static inline int destroyed = 0;
+
+    ~counted()
+    {
+        ++destroyed;
+    }
+};
+} // namespace
+
+
+TEST_CASE("arena for runtime_arrays", "[arena]")
+{
+    auto arena = bosswestfalen::runtime_array_arena{256};
+
+    SECTION("no memory before first use")
+    {
+        REQUIRE(arena.allocated() == 0);
+    }
+
+    SECTION("arrays share the blocks of the arena")
+    {
+        auto const a = test_array(4, 1, arena);
+        auto const b = test_array({1, 2, 3}, arena);
+        auto const allocated = arena.allocated();
+        REQUIRE(allocated == 256);
+
+        auto const c = a;
+        REQUIRE(c.get_allocator() == a.get_allocator());
+        REQUIRE(c == a);
+        REQUIRE(b.back() == 3);
+        REQUIRE(arena.allocated() == allocated);
+    }
+
+    SECTION("large arrays get their own block")
+    {
+        auto const rta = test_array(1000, 5, arena);
+        REQUIRE(arena.allocated() >= 1000 * sizeof(int));
+        REQUIRE(std::all_of(rta.cbegin(), rta.cend(), [](auto const i) { return i == 5; }));
+    }
+
+    SECTION("alignment is respected")
+    {
+        auto const chars = bosswestfalen::arena_runtime_array<char>(3, 'x', arena);
+        auto const doubles = bosswestfalen::arena_runtime_array<double>(3, 1.0, arena);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(doubles.data()) % alignof(double) == 0);
+
+        auto const p = arena.allocate(8, 64);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(p) % 64 == 0);
+    }
+
+    SECTION("non-trivial elements are still destroyed")
+    {
+        auto const text = std::string(100, 'x');
+        {
+            auto const rta = bosswestfalen::arena_runtime_array<std::string>(10, text, arena);
+            REQUIRE(rta[9] == text);
+        }
+
+        counted::destroyed = 0;
+        {
+            auto const rta = bosswestfalen::arena_runtime_array<counted>(10, arena);
+            REQUIRE(counted::destroyed == 0);
+        }
+        REQUIRE(counted::destroyed == 10);
+    }
+
+    SECTION("release gives back all memory")
+    {
+        {
+            auto const rta = test_array(100, arena);
+            REQUIRE(arena.allocated() > 0);
+        }
+        arena.release();
+        REQUIRE(arena.allocated() == 0);
+
+        auto const rta = test_array(1, 1, arena);
+        REQUIRE(rta.front() == 1);
+    }
+
+    SECTION("move assign between arenas copies into own arena")
+    {
+        auto other = bosswestfalen::runtime_array_arena{};
+        auto a = test_array(2, 1, arena);
+        auto b = test_array(2, 2, other);
+        a = std::move(b);
+        REQUIRE(std::addressof(a.get_allocator().arena()) == std::addressof(arena));
+        REQUIRE(a == test_array(2, 2, arena));
+    }
+}
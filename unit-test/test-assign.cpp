@@ -1,5 +1,6 @@
 #include "bosswestfalen/runtime_array.hpp"
 #include "catch/catch.hpp"
+#include <string>
 
 
 using test_array = bosswestfalen::runtime_array<int>;
@@ -81,3 +82,47 @@ TEST_CASE("assign", "[assign]")
     }
 }
 
+
+TEST_CASE("assign equally sized arrays", "[assign]")
+{
+    SECTION("memory is reused")
+    {
+        auto const src = test_array{4, 5, 6};
+        auto rta = test_array{1, 2, 3};
+        auto const data = rta.data();
+
+        rta = src;
+        REQUIRE(rta == src);
+        REQUIRE(rta.data() == data);
+        REQUIRE(src.data() not_eq data);
+    }
+
+    SECTION("trivially copyable elements")
+    {
+        struct point
+        {
+            double x;
+            double y;
+        };
+
+        auto const src = bosswestfalen::runtime_array<point>{{1, 2}, {3, 4}};
+        auto const copy = src;
+        REQUIRE(copy[1].x == 3);
+        REQUIRE(copy[1].y == 4);
+
+        auto rta = bosswestfalen::runtime_array<point>{{0, 0}, {0, 0}};
+        rta = src;
+        REQUIRE(rta[0].x == 1);
+        REQUIRE(rta[1].y == 4);
+    }
+
+    SECTION("elements whose assignment may throw")
+    {
+        using strings = bosswestfalen::runtime_array<std::string>;
+        auto const src = strings{"a", "b"};
+        auto rta = strings{"c", "d"};
+
+        rta = src;
+        REQUIRE(rta == src);
+    }
+}
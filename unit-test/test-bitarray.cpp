@@ -0,0 +1,211 @@
+#include "bosswestfalen/runtime_bitarray.hpp"
+#include "catch/catch.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+
+using test_bits = bosswestfalen::runtime_bitarray<>;
+
+
+TEST_CASE("creation of runtime_bitarrays", "[bitarray]")
+{
+    SECTION("empty")
+    {
+        auto const bits = test_bits{};
+        REQUIRE(bits.empty());
+        REQUIRE(bits.word_count() == 0);
+        REQUIRE(bits.none());
+        REQUIRE(bits.all());
+        REQUIRE(bits.find_first() == test_bits::npos);
+    }
+
+    SECTION("all bits 0")
+    {
+        auto const bits = test_bits(130);
+        REQUIRE(bits.size() == 130);
+        REQUIRE(bits.word_count() == 3);
+        REQUIRE(bits.count() == 0);
+        REQUIRE(bits.none());
+    }
+
+    SECTION("all bits 1, unused bits stay 0")
+    {
+        auto const bits = test_bits(130, true);
+        REQUIRE(bits.count() == 130);
+        REQUIRE(bits.all());
+        REQUIRE(bits.data()[2] == 0b11);
+
+        auto const full_words = test_bits(128, true);
+        REQUIRE(full_words.count() == 128);
+    }
+
+    SECTION("with initializer list")
+    {
+        auto const bits = test_bits{true, false, true, true};
+        REQUIRE(bits.size() == 4);
+        REQUIRE(bits.data()[0] == 0b1101);
+        REQUIRE(bits == test_bits{true, false, true, true});
+        REQUIRE(bits not_eq test_bits{true, false, true});
+        REQUIRE(bits not_eq test_bits{true, false, true, false});
+    }
+
+    SECTION("copy and move")
+    {
+        auto bits = test_bits(100, true);
+        auto const copy = bits;
+        REQUIRE(copy == bits);
+
+        auto moved = std::move(bits);
+        REQUIRE(moved.count() == 100);
+        REQUIRE(bits.empty());
+
+        bits = std::move(moved);
+        REQUIRE(bits.count() == 100);
+        REQUIRE(moved.empty());
+        REQUIRE(moved.none());
+    }
+
+    SECTION("trivially relocatable")
+    {
+        static_assert(bosswestfalen::is_trivially_relocatable_v<test_bits>);
+    }
+}
+
+
+TEST_CASE("access of runtime_bitarrays", "[bitarray]")
+{
+    auto bits = test_bits(200);
+
+    SECTION("single bits")
+    {
+        bits.set(3);
+        bits.set(64);
+        bits.set(199, true);
+        REQUIRE(bits.test(3));
+        REQUIRE(bits[64]);
+        REQUIRE(bits.at(199));
+        REQUIRE_FALSE(bits[65]);
+        REQUIRE(bits.count() == 3);
+
+        bits.reset(3);
+        bits.flip(64);
+        bits.flip(65);
+        REQUIRE_FALSE(bits[3]);
+        REQUIRE_FALSE(bits[64]);
+        REQUIRE(bits[65]);
+
+        REQUIRE_THROWS_AS(bits.at(200), std::out_of_range);
+        REQUIRE_THROWS_AS(std::as_const(bits).at(200), std::out_of_range);
+    }
+
+    SECTION("proxy references")
+    {
+        bits[10] = true;
+        bits[11] = bits[10];
+        bits[12].flip();
+        bits.at(13) = true;
+        REQUIRE(bits.count() == 4);
+
+        bits[10] = false;
+        REQUIRE(bits.find_first() == 11);
+    }
+
+    SECTION("fill")
+    {
+        bits.set();
+        REQUIRE(bits.all());
+        REQUIRE(bits.data()[3] == 0xff);
+
+        bits.reset();
+        REQUIRE(bits.none());
+
+        bits.fill(true);
+        REQUIRE(bits.count() == 200);
+    }
+
+    SECTION("find set bits")
+    {
+        for (auto const pos : {0, 63, 64, 150, 199})
+        {
+            bits.set(static_cast<std::size_t>(pos));
+        }
+
+        auto found = std::vector<std::size_t>{};
+        for (auto pos = bits.find_first(); pos not_eq test_bits::npos; pos = bits.find_next(pos))
+        {
+            found.push_back(pos);
+        }
+        REQUIRE(found == std::vector<std::size_t>{0, 63, 64, 150, 199});
+        REQUIRE(bits.find_next(199) == test_bits::npos);
+        REQUIRE(bits.find_next(500) == test_bits::npos);
+    }
+}
+
+
+TEST_CASE("bulk operations of runtime_bitarrays", "[bitarray]")
+{
+    auto a = test_bits(150);
+    auto b = test_bits(150);
+    for (auto i = std::size_t{0}; i < 150; ++i)
+    {
+        a.set(i, i % 2 == 0);
+        b.set(i, i % 3 == 0);
+    }
+
+    SECTION("and, or, xor")
+    {
+        REQUIRE((a & b).count() == 25);
+        REQUIRE((a | b).count() == 75 + 50 - 25);
+        REQUIRE((a ^ b).count() == 75 + 50 - 2 * 25);
+
+        a &= b;
+        REQUIRE(a.find_first() == 0);
+        REQUIRE(a.find_next(0) == 6);
+    }
+
+    SECTION("subtract")
+    {
+        a.subtract(b);
+        REQUIRE(a.count() == 50);
+        REQUIRE(a.find_first() == 2);
+    }
+
+    SECTION("not")
+    {
+        auto const inverted = ~a;
+        REQUIRE(inverted.count() == 75);
+        REQUIRE(inverted.find_first() == 1);
+        REQUIRE(inverted.data()[2] >> 22 == 0);
+
+        a.flip();
+        REQUIRE(a == inverted);
+    }
+
+    SECTION("sizes must match")
+    {
+        auto const other = test_bits(151);
+        REQUIRE_THROWS_AS(a &= other, std::invalid_argument);
+        REQUIRE_THROWS_AS(a | other, std::invalid_argument);
+    }
+}
+
+
+TEST_CASE("count of runtime_bitarrays spanning several blocks", "[bitarray]")
+{
+    // 32 words: the counting blocks of 31 words are crossed
+    auto bits = test_bits(1985, true);
+    REQUIRE(bits.word_count() == 32);
+    REQUIRE(bits.count() == 1985);
+
+    auto expected = std::size_t{0};
+    for (auto i = std::size_t{0}; i < bits.size(); ++i)
+    {
+        bits.set(i, i % 3 == 0 or i % 64 == 63);
+        expected += bits.test(i) ? 1 : 0;
+    }
+    REQUIRE(bits.count() == expected);
+
+    auto const many = test_bits(64 * 100 + 5, true);
+    REQUIRE(many.count() == 64 * 100 + 5);
+}
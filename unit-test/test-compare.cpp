@@ -1,5 +1,8 @@
 #include "bosswestfalen/runtime_array.hpp"
 #include "catch/catch.hpp"
+#include <cstddef>
+#include <limits>
+#include <string>
 
 
 using test_array = bosswestfalen::runtime_array<int>;
@@ -56,3 +59,155 @@ TEST_CASE("compare", "[compare]")
     }
 }
 
+
+TEST_CASE("compare large arrays", "[compare]")
+{
+    constexpr auto Size = std::size_t{1000};
+
+    SECTION("bytes")
+    {
+        auto a = bosswestfalen::runtime_array<unsigned char>(Size, 0x80);
+        auto b = a;
+        REQUIRE(a == b);
+        REQUIRE_FALSE(a < b);
+        REQUIRE(a.mismatch(b) == Size);
+
+        b[Size - 1] = 0x7f;
+        REQUIRE(a not_eq b);
+        REQUIRE(b < a);
+        REQUIRE_FALSE(a < b);
+        REQUIRE(a.mismatch(b) == Size - 1);
+
+        auto const prefix = bosswestfalen::runtime_array<unsigned char>(Size / 2, 0x80);
+        REQUIRE(prefix < a);
+        REQUIRE(prefix.mismatch(a) == Size / 2);
+
+        auto const bytes = bosswestfalen::runtime_array<std::byte>(Size, std::byte{1});
+        auto const larger = bosswestfalen::runtime_array<std::byte>(Size, std::byte{2});
+        REQUIRE(bytes < larger);
+        REQUIRE(bytes.mismatch(larger) == 0);
+    }
+
+    SECTION("signed integers")
+    {
+        auto a = bosswestfalen::runtime_array<long>(Size, 5);
+        auto b = a;
+        b[700] = -1;
+        REQUIRE(a not_eq b);
+        REQUIRE(b < a);
+        REQUIRE(a.mismatch(b) == 700);
+        REQUIRE(b.mismatch(a) == 700);
+    }
+
+    SECTION("floating point")
+    {
+        auto a = bosswestfalen::runtime_array<double>(Size, 0.0);
+        auto b = bosswestfalen::runtime_array<double>(Size, -0.0);
+        REQUIRE(a == b);
+        REQUIRE(a.mismatch(b) == Size);
+        REQUIRE_FALSE(a < b);
+        REQUIRE_FALSE(b < a);
+
+        b[300] = 1.0;
+        REQUIRE(a < b);
+        REQUIRE(a.mismatch(b) == 300);
+
+        // NaN is not equal, but neither less nor greater
+        a[100] = std::numeric_limits<double>::quiet_NaN();
+        REQUIRE(a not_eq a);
+        REQUIRE(a.mismatch(a) == 100);
+        REQUIRE(a < b);
+        REQUIRE_FALSE(b < a);
+    }
+
+    SECTION("other types")
+    {
+        auto const a = bosswestfalen::runtime_array<std::string>{"a", "b", "c"};
+        auto const b = bosswestfalen::runtime_array<std::string>{"a", "c"};
+        REQUIRE(a < b);
+        REQUIRE(a.mismatch(b) == 1);
+        REQUIRE(a.mismatch(a) == 3);
+    }
+}
+
+TEST_CASE("three-way compare", "[compare]")
+{
+    auto const empty = test_array{};
+    auto const a = test_array{1, 2, 3};
+    auto const b = test_array{1, 2, 4};
+    auto const prefix = test_array{1, 2};
+
+    SECTION("compare")
+    {
+        REQUIRE(empty.compare(empty) == 0);
+        REQUIRE(a.compare(a) == 0);
+        REQUIRE(a.compare(b) == -1);
+        REQUIRE(b.compare(a) == 1);
+        REQUIRE(prefix.compare(a) == -1);
+        REQUIRE(a.compare(prefix) == 1);
+        REQUIRE(empty.compare(a) == -1);
+    }
+
+    SECTION("relational operators")
+    {
+        REQUIRE(b > a);
+        REQUIRE_FALSE(a > a);
+        REQUIRE(a >= a);
+        REQUIRE(b >= a);
+        REQUIRE_FALSE(a >= b);
+        REQUIRE(a <= a);
+        REQUIRE(prefix <= a);
+        REQUIRE_FALSE(b <= a);
+    }
+
+#if defined(__cpp_impl_three_way_comparison) and __has_include(<compare>)
+    SECTION("operator<=>")
+    {
+        REQUIRE(std::is_eq(a <=> a));
+        REQUIRE(std::is_lt(a <=> b));
+        REQUIRE(std::is_gt(b <=> prefix));
+
+        using doubles = bosswestfalen::runtime_array<double>;
+        auto const nan = std::numeric_limits<double>::quiet_NaN();
+        REQUIRE((doubles{nan} <=> doubles{1.0}) == std::partial_ordering::unordered);
+        REQUIRE((doubles{1.0, nan} <=> doubles{1.0, 2.0}) == std::partial_ordering::unordered);
+        REQUIRE(std::is_lt(doubles{0.0, nan} <=> doubles{1.0, nan}));
+        REQUIRE(std::is_eq(doubles{-0.0, 1.0} <=> doubles{0.0, 1.0}));
+        REQUIRE(std::is_lt(doubles{1.0} <=> doubles{1.0, nan}));
+    }
+#endif
+
+    SECTION("bytes")
+    {
+        using bytes = bosswestfalen::runtime_array<unsigned char>;
+        REQUIRE(bytes{0x01, 0xff}.compare(bytes{0x02}) == -1);
+        REQUIRE(bytes{0xff}.compare(bytes{0x01, 0x00}) == 1);
+        REQUIRE(bytes{0x01}.compare(bytes{0x01, 0x00}) == -1);
+        REQUIRE(bytes{0x01, 0x02}.compare(bytes{0x01, 0x02}) == 0);
+    }
+
+    SECTION("each pair of elements is visited once")
+    {
+        struct counted
+        {
+            int value;
+            int* calls;
+
+            bool operator<(counted const& rhs) const
+            {
+                ++*calls;
+                return value < rhs.value;
+            }
+        };
+
+        auto calls = 0;
+        auto const x = bosswestfalen::runtime_array<counted>{{1, &calls}, {2, &calls}, {3, &calls}};
+        auto const y = bosswestfalen::runtime_array<counted>{{1, &calls}, {2, &calls}, {4, &calls}};
+
+        REQUIRE(x <= y);
+        REQUIRE(calls == 5);
+        calls = 0;
+        REQUIRE_FALSE(x >= y);
+        REQUIRE(calls == 5);
+    }
+}
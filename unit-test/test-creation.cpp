@@ -1,5 +1,13 @@
 #include "bosswestfalen/runtime_array.hpp"
 #include "catch/catch.hpp"
+#include <forward_list>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <sstream>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 
@@ -108,3 +116,215 @@ TEST_CASE("creation of runtime_arrays", "[create]")
     }
 }
 
+
+TEST_CASE("creation with explicit initialisation", "[create]")
+{
+    constexpr auto Size = 4;
+
+    SECTION("for overwrite")
+    {
+        auto rta = test_array(Size, bosswestfalen::for_overwrite);
+        REQUIRE(rta.size() == Size);
+        std::fill(rta.begin(), rta.end(), 3);
+        REQUIRE(rta == test_array{3, 3, 3, 3});
+
+        auto const made = bosswestfalen::make_runtime_array_for_overwrite<double>(Size);
+        REQUIRE(made.size() == Size);
+
+        auto const empty = test_array(0, bosswestfalen::for_overwrite);
+        REQUIRE(empty.empty());
+    }
+
+    SECTION("for overwrite default-initialises non-trivial elements")
+    {
+        auto const rta = bosswestfalen::runtime_array<std::string>(Size, bosswestfalen::for_overwrite);
+        REQUIRE(std::all_of(rta.cbegin(), rta.cend(), [](auto const& s) { return s.empty(); }));
+    }
+
+    SECTION("value initialise")
+    {
+        auto const ints = test_array(Size, bosswestfalen::value_initialise);
+        REQUIRE(ints == test_array{0, 0, 0, 0});
+
+        auto const pointers = bosswestfalen::runtime_array<int*>(Size, bosswestfalen::value_initialise);
+        REQUIRE(std::all_of(pointers.cbegin(), pointers.cend(), [](auto const p) { return p == nullptr; }));
+
+        struct aggregate
+        {
+            int i;
+            double d;
+        };
+        auto const aggregates = bosswestfalen::runtime_array<aggregate>(Size, bosswestfalen::value_initialise);
+        REQUIRE(aggregates.back().i == 0);
+        REQUIRE(aggregates.back().d == 0.0);
+    }
+
+    SECTION("value initialise with allocator")
+    {
+        auto resource = std::pmr::monotonic_buffer_resource{};
+        auto const rta = bosswestfalen::pmr::runtime_array<int>(Size, bosswestfalen::value_initialise, &resource);
+        REQUIRE(std::all_of(rta.cbegin(), rta.cend(), [](auto const i) { return i == 0; }));
+    }
+}
+
+namespace
+{
+/// element without default ctor, that cannot be copied or moved
+struct pinned
+{
+    static inline int alive{0};
+
+    explicit pinned(std::size_t const v)
+        : value{v}
+    {
+        ++alive;
+    }
+
+    pinned(pinned const&) = delete;
+    pinned& operator=(pinned const&) = delete;
+
+    ~pinned()
+    {
+        --alive;
+    }
+
+    std::size_t value;
+};
+} // namespace
+
+
+TEST_CASE("creation with generator", "[create]")
+{
+    SECTION("element i is f(i)")
+    {
+        auto const rta = test_array(4, bosswestfalen::generate, [](std::size_t const i) { return static_cast<int>(i * i); });
+        REQUIRE(rta == test_array{0, 1, 4, 9});
+
+        auto const empty = test_array(0, bosswestfalen::generate, [](std::size_t) { return 1; });
+        REQUIRE(empty.empty());
+    }
+
+    SECTION("elements are constructed in place")
+    {
+        {
+            auto const rta = bosswestfalen::runtime_array<pinned>(3, bosswestfalen::generate, [](std::size_t const i) { return pinned{i + 1}; });
+            REQUIRE(rta.back().value == 3);
+            REQUIRE(pinned::alive == 3);
+        }
+        REQUIRE(pinned::alive == 0);
+    }
+
+    SECTION("exception safety")
+    {
+        auto const f = [](std::size_t const i)
+        {
+            if (i == 3)
+            {
+                throw std::runtime_error{"generator"};
+            }
+            return pinned{i};
+        };
+        REQUIRE_THROWS_AS(bosswestfalen::runtime_array<pinned>(5, bosswestfalen::generate, f), std::runtime_error);
+        REQUIRE(pinned::alive == 0);
+    }
+
+    SECTION("allocator aware elements")
+    {
+        auto resource = std::pmr::monotonic_buffer_resource{};
+        auto const rta = bosswestfalen::pmr::runtime_array<std::pmr::string>(2, bosswestfalen::generate,
+                                                                                [](std::size_t const i) { return std::string(50, static_cast<char>('a' + i)); },
+                                                                                &resource);
+        REQUIRE(rta[1] == std::pmr::string(50, 'b'));
+        REQUIRE(rta[1].get_allocator().resource() == &resource);
+    }
+}
+
+
+TEST_CASE("creation from ranges", "[create]")
+{
+    auto numbers = std::string{};
+    for (auto i = 0; i < 2000; ++i)
+    {
+        numbers += std::to_string(i) + ' ';
+    }
+
+    SECTION("input iterators are read once")
+    {
+        auto in = std::istringstream{numbers};
+        auto const rta = test_array(std::istream_iterator<int>{in}, std::istream_iterator<int>{});
+        REQUIRE(rta.size() == 2000);
+        REQUIRE(rta.front() == 0);
+        REQUIRE(rta.back() == 1999);
+    }
+
+    SECTION("empty input range")
+    {
+        auto in = std::istringstream{};
+        auto const rta = test_array(std::istream_iterator<int>{in}, std::istream_iterator<int>{});
+        REQUIRE(rta.empty());
+        REQUIRE(rta.data() == nullptr);
+    }
+
+    SECTION("input iterators of non-trivial elements")
+    {
+        auto in = std::istringstream{numbers};
+        auto const rta = bosswestfalen::runtime_array<std::string>(std::istream_iterator<std::string>{in},
+                                                                   std::istream_iterator<std::string>{});
+        REQUIRE(rta.size() == 2000);
+        REQUIRE(rta[1234] == "1234");
+    }
+
+    SECTION("size hint")
+    {
+        for (auto const hint : {std::size_t{0}, std::size_t{10}, std::size_t{2000}, std::size_t{5000}})
+        {
+            auto in = std::istringstream{numbers};
+            auto const rta = test_array(std::istream_iterator<int>{in}, std::istream_iterator<int>{}, hint);
+            REQUIRE(rta.size() == 2000);
+            REQUIRE(rta.back() == 1999);
+        }
+
+        auto const list = std::list<int>{1, 2, 3};
+        REQUIRE(test_array(list.begin(), list.end(), 3) == test_array{1, 2, 3});
+    }
+
+    SECTION("first n elements")
+    {
+        auto in = std::istringstream{"1 2 3 4"};
+        auto const rta = test_array(std::istream_iterator<int>{in}, 3);
+        REQUIRE(rta == test_array{1, 2, 3});
+
+        auto next = 0;
+        in >> next;
+        REQUIRE(next == 4);
+    }
+
+    SECTION("elements of move_iterators are moved")
+    {
+        auto src = std::vector<std::unique_ptr<int>>{};
+        src.push_back(std::make_unique<int>(1));
+        src.push_back(std::make_unique<int>(2));
+
+        auto const rta = bosswestfalen::runtime_array<std::unique_ptr<int>>(std::make_move_iterator(src.begin()),
+                                                                            std::make_move_iterator(src.end()));
+        REQUIRE(*rta[1] == 2);
+        REQUIRE(src[0] == nullptr);
+
+        auto ints = test_array{1, 2, 3};
+        auto const moved = test_array(std::make_move_iterator(ints.begin()), std::make_move_iterator(ints.end()));
+        REQUIRE(moved == ints);
+    }
+
+    SECTION("from_range")
+    {
+        auto const list = std::list<std::string>{"a", "b", "c"};
+        auto const sized = bosswestfalen::runtime_array<std::string>(bosswestfalen::from_range, list);
+        REQUIRE(sized.size() == 3);
+        REQUIRE(sized[2] == "c");
+
+        auto const forward_list = std::forward_list<int>{4, 5};
+        REQUIRE(test_array(bosswestfalen::from_range, forward_list) == test_array{4, 5});
+
+        REQUIRE(test_array(bosswestfalen::from_range, std::vector<int>{}).empty());
+    }
+}
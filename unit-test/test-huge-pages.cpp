@@ -0,0 +1,41 @@
+#include "bosswestfalen/huge_page_allocator.hpp"
+#include "catch/catch.hpp"
+#include <cstdint>
+
+
+using test_array = bosswestfalen::huge_page_runtime_array<std::uint64_t>;
+
+
+TEST_CASE("huge page backed runtime_arrays", "[huge-pages]")
+{
+    constexpr auto Large = 3 * bosswestfalen::huge_page_size / sizeof(std::uint64_t) + 1;
+
+    SECTION("small arrays use the normal heap")
+    {
+        auto const rta = test_array(16, 1);
+        REQUIRE_FALSE(test_array::allocator_type::uses_huge_pages(rta.size()));
+        REQUIRE(rta.back() == 1);
+    }
+
+    SECTION("large arrays are aligned to huge pages")
+    {
+        auto rta = test_array(Large, 7);
+        REQUIRE(test_array::allocator_type::uses_huge_pages(rta.size()));
+        REQUIRE(reinterpret_cast<std::uintptr_t>(rta.data()) % bosswestfalen::huge_page_size == 0);
+        REQUIRE(rta.front() == 7);
+        REQUIRE(rta.back() == 7);
+
+        rta.back() = 8;
+        auto const copy = rta;
+        REQUIRE(copy == rta);
+    }
+
+    SECTION("threshold is configurable")
+    {
+        using small_threshold = bosswestfalen::huge_page_runtime_array<std::uint64_t, 4096>;
+        auto const rta = small_threshold(4096 / sizeof(std::uint64_t), 3);
+        REQUIRE(small_threshold::allocator_type::uses_huge_pages(rta.size()));
+        REQUIRE(reinterpret_cast<std::uintptr_t>(rta.data()) % bosswestfalen::huge_page_size == 0);
+        REQUIRE(rta[10] == 3);
+    }
+}
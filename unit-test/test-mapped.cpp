@@ -0,0 +1,137 @@
+#include "bosswestfalen/mapped_runtime_array.hpp"
+#include "catch/catch.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+using test_array = bosswestfalen::mapped_runtime_array<std::int32_t>;
+using read_only_array = bosswestfalen::mapped_runtime_array<std::int32_t const>;
+using bosswestfalen::map_mode;
+
+
+namespace
+{
+/// temporary file, removed at the end of the test
+class temporary_file final
+{
+  public:
+    explicit temporary_file(std::vector<std::int32_t> const& content)
+        : m_path{(std::filesystem::temp_directory_path() / ("bwf-mapped-" + std::to_string(::getpid()))).string()}
+    {
+        auto file = std::ofstream{m_path, std::ios::binary};
+        file.write(reinterpret_cast<char const*>(content.data()),
+                   static_cast<std::streamsize>(content.size() * sizeof(std::int32_t)));
+    }
+
+    ~temporary_file()
+    {
+        std::filesystem::remove(m_path);
+    }
+
+    temporary_file(temporary_file const&) = delete;
+    temporary_file& operator=(temporary_file const&) = delete;
+
+    auto path() const -> std::string const&
+    {
+        return m_path;
+    }
+
+  private:
+    std::string m_path;
+};
+} // namespace
+
+
+TEST_CASE("memory mapped runtime_arrays", "[mapped]")
+{
+    auto const content = std::vector<std::int32_t>{1, 2, 3, 4};
+    auto const file = temporary_file{content};
+
+    SECTION("empty array")
+    {
+        auto const rta = test_array{};
+        REQUIRE(rta.empty());
+        REQUIRE(rta.data() == nullptr);
+    }
+
+    SECTION("read only")
+    {
+        auto rta = read_only_array{file.path()};
+        REQUIRE(rta.mode() == map_mode::read_only);
+        REQUIRE(rta.size() == content.size());
+        REQUIRE(std::equal(rta.cbegin(), rta.cend(), content.cbegin()));
+        REQUIRE(rta.at(3) == 4);
+        REQUIRE_THROWS_AS(rta.at(4), std::out_of_range);
+
+        // even a non-const array hands out no mutable access
+        STATIC_REQUIRE(std::is_same_v<decltype(rta[0]), std::int32_t const&>);
+        STATIC_REQUIRE(std::is_same_v<decltype(rta.at(0)), std::int32_t const&>);
+        STATIC_REQUIRE(std::is_same_v<decltype(rta.data()), std::int32_t const*>);
+        STATIC_REQUIRE(std::is_same_v<read_only_array::value_type, std::int32_t>);
+    }
+
+    SECTION("mode has to match the constness of the elements")
+    {
+        REQUIRE(test_array{file.path()}.mode() == map_mode::copy_on_write);
+        REQUIRE_THROWS_AS(test_array(file.path(), map_mode::read_only), std::invalid_argument);
+        REQUIRE_THROWS_AS(read_only_array(file.path(), map_mode::shared), std::invalid_argument);
+        REQUIRE_THROWS_AS(read_only_array(file.path(), map_mode::copy_on_write), std::invalid_argument);
+    }
+
+    SECTION("copy on write")
+    {
+        {
+            auto rta = test_array{file.path(), map_mode::copy_on_write};
+            rta.fill(9);
+            REQUIRE(rta.front() == 9);
+        }
+        auto const rta = read_only_array{file.path()};
+        REQUIRE(rta.front() == 1);
+    }
+
+    SECTION("shared")
+    {
+        {
+            auto rta = test_array{file.path(), map_mode::shared};
+            rta[0] = 42;
+            rta.sync();
+        }
+        auto const rta = read_only_array{file.path()};
+        REQUIRE(rta.front() == 42);
+    }
+
+    SECTION("create file with given size")
+    {
+        {
+            auto rta = test_array{file.path(), 8};
+            REQUIRE(rta.size() == 8);
+            REQUIRE(rta[0] == 1);
+            REQUIRE(rta[7] == 0);
+            rta.back() = 7;
+        }
+        auto const rta = read_only_array{file.path()};
+        REQUIRE(rta.size() == 8);
+        REQUIRE(rta.back() == 7);
+    }
+
+    SECTION("move and compare")
+    {
+        auto a = test_array{file.path()};
+        auto const b = test_array{file.path()};
+        REQUIRE(a == b);
+
+        auto const c = std::move(a);
+        REQUIRE(a.empty());
+        REQUIRE(c == b);
+        REQUIRE(a < c);
+    }
+
+    SECTION("missing file")
+    {
+        REQUIRE_THROWS_AS(test_array{file.path() + "-missing"}, std::system_error);
+    }
+}
@@ -0,0 +1,150 @@
+#include "bosswestfalen/runtime_mdarray.hpp"
+#include "catch/catch.hpp"
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+using bosswestfalen::dextents;
+using bosswestfalen::extents;
+using bosswestfalen::full_extent;
+using bosswestfalen::layout_left;
+using bosswestfalen::mdspan;
+using bosswestfalen::runtime_array2d;
+
+
+namespace
+{
+/// sum all elements of a matrix view
+template <typename Layout>
+int sum(mdspan<int const, dextents<2>, Layout> const matrix)
+{
+    auto result = 0;
+    for (auto i = std::size_t{0}; i < matrix.extent(0); ++i)
+    {
+        for (auto j = std::size_t{0}; j < matrix.extent(1); ++j)
+        {
+            result += matrix(i, j);
+        }
+    }
+    return result;
+}
+} // namespace
+
+
+TEST_CASE("creation of runtime_mdarrays", "[mdarray]")
+{
+    SECTION("empty")
+    {
+        auto const matrix = runtime_array2d<int>{};
+        REQUIRE(matrix.empty());
+        REQUIRE(matrix.extent(0) == 0);
+        REQUIRE(matrix.container().empty());
+    }
+
+    SECTION("with extents")
+    {
+        auto const matrix = runtime_array2d<std::string>(2, 3);
+        REQUIRE(matrix.size() == 6);
+        REQUIRE(matrix.container().size() == 6);
+        REQUIRE(matrix(1, 2).empty());
+    }
+
+    SECTION("static extents")
+    {
+        auto const matrix = bosswestfalen::runtime_mdarray<int, extents<3, 3>>{};
+        REQUIRE(matrix.size() == 9);
+
+        auto const cube = bosswestfalen::runtime_arraynd<int, 3>(dextents<3>{2, 2, 2}, 5);
+        REQUIRE(cube(1, 1, 1) == 5);
+    }
+
+    SECTION("with initialisation")
+    {
+        auto const zeros = runtime_array2d<int>(dextents<2>{4, 4}, bosswestfalen::value_initialise);
+        REQUIRE(sum(zeros.view()) == 0);
+
+        auto overwritten = runtime_array2d<int>(dextents<2>{4, 4}, bosswestfalen::for_overwrite);
+        std::fill(overwritten.data(), overwritten.data() + overwritten.size(), 1);
+        REQUIRE(sum(std::as_const(overwritten).view()) == 16);
+    }
+
+    SECTION("from a flat runtime_array")
+    {
+        auto flat = bosswestfalen::runtime_array<int>(6);
+        std::iota(flat.begin(), flat.end(), 0);
+        auto const data = flat.data();
+
+        auto matrix = runtime_array2d<int>(dextents<2>{2, 3}, std::move(flat));
+        REQUIRE(matrix.data() == data);
+        REQUIRE(matrix(1, 0) == 3);
+
+        auto const back = std::move(matrix).extract_container();
+        REQUIRE(back.data() == data);
+        REQUIRE(matrix.empty());
+
+        auto small = bosswestfalen::runtime_array<int>(5);
+        REQUIRE_THROWS_AS(runtime_array2d<int>(dextents<2>{2, 3}, std::move(small)), std::length_error);
+        REQUIRE(small.size() == 5);
+    }
+
+    SECTION("copy and move")
+    {
+        auto matrix = runtime_array2d<int>(dextents<2>{2, 2}, 1);
+        auto copy = matrix;
+        REQUIRE(copy == matrix);
+
+        copy(0, 1) = 2;
+        REQUIRE(copy not_eq matrix);
+
+        auto const moved = std::move(copy);
+        REQUIRE(moved(0, 1) == 2);
+
+        auto other = runtime_array2d<int>(1, 1);
+        swap(matrix, other);
+        REQUIRE(matrix.size() == 1);
+        REQUIRE(other.size() == 4);
+
+        REQUIRE(runtime_array2d<int>(dextents<2>{2, 3}, 0) not_eq runtime_array2d<int>(dextents<2>{3, 2}, 0));
+    }
+}
+
+
+TEST_CASE("access of runtime_mdarrays", "[mdarray]")
+{
+    auto matrix = runtime_array2d<int>(3, 4);
+    std::iota(matrix.data(), matrix.data() + matrix.size(), 0);
+
+    SECTION("elements")
+    {
+        REQUIRE(matrix(2, 1) == 9);
+        REQUIRE(std::as_const(matrix)(1, 1) == 5);
+        REQUIRE(matrix.at(2, 3) == 11);
+        REQUIRE_THROWS_AS(matrix.at(3, 0), std::out_of_range);
+        REQUIRE(matrix.stride(0) == 4);
+    }
+
+    SECTION("column-major")
+    {
+        auto columns = runtime_array2d<int, layout_left>(3, 4);
+        std::iota(columns.data(), columns.data() + columns.size(), 0);
+        REQUIRE(columns(2, 1) == 5);
+        REQUIRE(columns.stride(1) == 3);
+    }
+
+    SECTION("views")
+    {
+        mdspan<int const, dextents<2>> const converted = matrix;
+        REQUIRE(sum(converted) == 66);
+
+        auto const view = matrix.view();
+        view(0, 0) = 100;
+        REQUIRE(matrix(0, 0) == 100);
+
+        auto const right = bosswestfalen::submdspan(matrix.view(), full_extent, std::pair{2, 4});
+        REQUIRE(right.extent(1) == 2);
+        REQUIRE(right(2, 0) == 10);
+        REQUIRE(sum(bosswestfalen::submdspan(std::as_const(matrix).view(), std::pair{1, 3}, std::pair{0, 2})) == 4 + 5 + 8 + 9);
+    }
+}
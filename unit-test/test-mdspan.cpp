@@ -0,0 +1,206 @@
+#include "bosswestfalen/mdspan.hpp"
+#include "catch/catch.hpp"
+#include <array>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+
+using bosswestfalen::dextents;
+using bosswestfalen::dynamic_extent;
+using bosswestfalen::extents;
+using bosswestfalen::full_extent;
+using bosswestfalen::layout_left;
+using bosswestfalen::layout_right;
+using bosswestfalen::layout_stride;
+using bosswestfalen::mdspan;
+using bosswestfalen::submdspan;
+
+
+TEST_CASE("extents", "[mdspan]")
+{
+    SECTION("static and dynamic extents")
+    {
+        using mixed = extents<3, dynamic_extent, 4>;
+        static_assert(mixed::rank() == 3);
+        static_assert(mixed::rank_dynamic() == 1);
+        static_assert(mixed::static_extent(1) == dynamic_extent);
+        static_assert(sizeof(extents<3, 4>) == 1);
+
+        constexpr auto e = mixed{5};
+        static_assert(e.extent(0) == 3);
+        static_assert(e.extent(1) == 5);
+        static_assert(e.extent(2) == 4);
+        static_assert(e.product(0, 3) == 60);
+
+        REQUIRE(mixed(3, 7, 4).extent(1) == 7);
+        REQUIRE(mixed{5} == dextents<3>{3, 5, 4});
+        REQUIRE(mixed{5} not_eq dextents<3>{3, 6, 4});
+        REQUIRE(mixed{5} not_eq dextents<2>{3, 5});
+    }
+
+    SECTION("conversion to dynamic extents")
+    {
+        auto const e = dextents<2>{extents<2, 3>{}};
+        REQUIRE(e.extent(0) == 2);
+        REQUIRE(e.extent(1) == 3);
+    }
+}
+
+
+TEST_CASE("layouts", "[mdspan]")
+{
+    auto const e = dextents<3>{2, 3, 4};
+
+    SECTION("layout_right")
+    {
+        auto const m = layout_right::mapping<dextents<3>>{e};
+        REQUIRE(m(0, 0, 1) == 1);
+        REQUIRE(m(0, 1, 0) == 4);
+        REQUIRE(m(1, 0, 0) == 12);
+        REQUIRE(m(1, 2, 3) == 23);
+        REQUIRE(m.required_span_size() == 24);
+        REQUIRE(m.stride(0) == 12);
+        REQUIRE(m.stride(2) == 1);
+    }
+
+    SECTION("layout_left")
+    {
+        auto const m = layout_left::mapping<dextents<3>>{e};
+        REQUIRE(m(1, 0, 0) == 1);
+        REQUIRE(m(0, 1, 0) == 2);
+        REQUIRE(m(0, 0, 1) == 6);
+        REQUIRE(m(1, 2, 3) == 23);
+        REQUIRE(m.required_span_size() == 24);
+        REQUIRE(m.stride(0) == 1);
+        REQUIRE(m.stride(2) == 6);
+    }
+
+    SECTION("layout_stride")
+    {
+        auto const m = layout_stride::mapping<dextents<2>>{dextents<2>{2, 3}, {10, 2}};
+        REQUIRE(m(1, 2) == 14);
+        REQUIRE(m.required_span_size() == 15);
+
+        auto const from_right = layout_stride::mapping<dextents<3>>{layout_right::mapping<dextents<3>>{e}};
+        REQUIRE(from_right.strides() == std::array<std::size_t, 3>{12, 4, 1});
+
+        auto const empty = layout_stride::mapping<dextents<2>>{dextents<2>{0, 3}, {3, 1}};
+        REQUIRE(empty.required_span_size() == 0);
+    }
+
+    SECTION("static extents are folded into the index computation")
+    {
+        constexpr auto m = layout_right::mapping<extents<4, 8>>{};
+        static_assert(m(3, 5) == 29);
+        static_assert(m.required_span_size() == 32);
+    }
+}
+
+
+TEST_CASE("mdspan", "[mdspan]")
+{
+    auto storage = std::array<int, 12>{};
+    std::iota(storage.begin(), storage.end(), 0);
+
+    SECTION("access")
+    {
+        auto const matrix = mdspan<int, dextents<2>>(storage.data(), 3, 4);
+        REQUIRE(matrix.rank() == 2);
+        REQUIRE(matrix.extent(0) == 3);
+        REQUIRE(matrix.extent(1) == 4);
+        REQUIRE(matrix.size() == 12);
+        REQUIRE(matrix(2, 1) == 9);
+        REQUIRE(matrix(std::array<std::size_t, 2>{1, 3}) == 7);
+
+        matrix(0, 0) = 100;
+        REQUIRE(storage[0] == 100);
+
+        REQUIRE(matrix.at(2, 3) == 11);
+        REQUIRE_THROWS_AS(matrix.at(3, 0), std::out_of_range);
+        REQUIRE_THROWS_AS(matrix.at(0, 4), std::out_of_range);
+    }
+
+    SECTION("column-major")
+    {
+        auto const matrix = mdspan<int, dextents<2>, layout_left>(storage.data(), 3, 4);
+        REQUIRE(matrix(2, 1) == 5);
+        REQUIRE(matrix.stride(1) == 3);
+    }
+
+    SECTION("static extents")
+    {
+        auto const matrix = mdspan<int, extents<3, 4>>(storage.data());
+        REQUIRE(matrix(1, 1) == 5);
+
+        auto const partial = mdspan<int, extents<dynamic_extent, 4>>(storage.data(), 3);
+        REQUIRE(partial(2, 3) == 11);
+    }
+
+    SECTION("conversions")
+    {
+        auto const matrix = mdspan<int, extents<3, 4>>(storage.data());
+        mdspan<int const, dextents<2>> const read_only = matrix;
+        REQUIRE(read_only.extent(0) == 3);
+        REQUIRE(read_only(2, 2) == 10);
+
+        mdspan<int, dextents<2>, layout_stride> const strided = matrix;
+        REQUIRE(strided(2, 2) == 10);
+    }
+}
+
+
+TEST_CASE("submdspan", "[mdspan]")
+{
+    auto storage = std::array<int, 24>{};
+    std::iota(storage.begin(), storage.end(), 0);
+    auto const cube = mdspan<int, dextents<3>>(storage.data(), 2, 3, 4);
+
+    SECTION("sub-block")
+    {
+        auto const block = submdspan(cube, full_extent, std::pair{1, 3}, std::pair{1, 3});
+        REQUIRE(block.rank() == 3);
+        REQUIRE(block.extent(0) == 2);
+        REQUIRE(block.extent(1) == 2);
+        REQUIRE(block.extent(2) == 2);
+        REQUIRE(block(0, 0, 0) == 5);
+        REQUIRE(block(1, 1, 1) == 22);
+
+        block(0, 0, 0) = -1;
+        REQUIRE(cube(0, 1, 1) == -1);
+    }
+
+    SECTION("indices remove dimensions")
+    {
+        auto const plane = submdspan(cube, 1, full_extent, full_extent);
+        REQUIRE(plane.rank() == 2);
+        REQUIRE(plane(2, 3) == 23);
+
+        auto const column = submdspan(cube, 0, full_extent, 2);
+        REQUIRE(column.rank() == 1);
+        REQUIRE(column.extent(0) == 3);
+        REQUIRE(column.stride(0) == 4);
+        REQUIRE(column(2) == 10);
+
+        auto const element = submdspan(cube, 1, 1, 1);
+        REQUIRE(element.rank() == 0);
+        REQUIRE(element() == 17);
+    }
+
+    SECTION("slices of slices")
+    {
+        auto const plane = submdspan(cube, 1, full_extent, full_extent);
+        auto const row = submdspan(plane, 2, std::pair{1, 4});
+        REQUIRE(row.extent(0) == 3);
+        REQUIRE(row(0) == 21);
+        REQUIRE(row(2) == 23);
+    }
+
+    SECTION("column-major")
+    {
+        auto const matrix = mdspan<int, dextents<2>, layout_left>(storage.data(), 4, 6);
+        auto const column = submdspan(matrix, full_extent, 5);
+        REQUIRE(column.stride(0) == 1);
+        REQUIRE(column(3) == 23);
+    }
+}
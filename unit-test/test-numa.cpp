@@ -0,0 +1,141 @@
+#include "bosswestfalen/numa_allocator.hpp"
+#include "catch/catch.hpp"
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+
+
+using test_array = bosswestfalen::numa_runtime_array<std::uint64_t>;
+
+
+#if BOSSWESTFALEN_HAS_MBIND
+namespace
+{
+/// policy mode of the page at p
+auto mode_of(void const* const p) -> int
+{
+    auto mode = -1;
+    auto mask = 0ul;
+    ::syscall(SYS_get_mempolicy, &mode, &mask, sizeof(mask) * 8 + 1, p, MPOL_F_ADDR);
+    return mode;
+}
+
+/// node of the page at p, which must have been touched
+auto node_of(void const* const p) -> int
+{
+    auto node = -1;
+    ::syscall(SYS_get_mempolicy, &node, nullptr, 0, p, MPOL_F_ADDR | MPOL_F_NODE);
+    return node;
+}
+} // namespace
+#endif
+
+
+TEST_CASE("node lists are parsed into masks", "[numa]")
+{
+    auto parse = [](char const* list) {
+        auto in = std::istringstream{list};
+        return bosswestfalen::detail::parse_node_list(in);
+    };
+
+    REQUIRE(parse("0") == 0b1);
+    REQUIRE(parse("0-1") == 0b11);
+    REQUIRE(parse("0-1,3\n") == 0b1011);
+    REQUIRE(parse("2,4-5") == 0b110100);
+    REQUIRE(parse("") == 0);
+
+    REQUIRE(bosswestfalen::numa_online_nodes() not_eq 0);
+    REQUIRE(bosswestfalen::numa_node_count() >= 1);
+
+#if defined(__linux__) and __has_include(<linux/mempolicy.h>)
+    // bind and interleave would silently do nothing otherwise
+    REQUIRE(BOSSWESTFALEN_HAS_MBIND == 1);
+#endif
+}
+
+TEST_CASE("numa policies", "[numa]")
+{
+    using bosswestfalen::numa_placement;
+    using bosswestfalen::numa_policy;
+
+    REQUIRE(numa_policy{}.placement() == numa_placement::first_touch);
+    REQUIRE(numa_policy::first_touch() == numa_policy{});
+    REQUIRE(numa_policy::bind(2).placement() == numa_placement::bind);
+    REQUIRE(numa_policy::bind(2).nodes() == 0b100);
+    REQUIRE(numa_policy::interleave(0b11).placement() == numa_placement::interleave);
+    REQUIRE(numa_policy::interleave().nodes() == numa_policy::all_nodes);
+    REQUIRE(numa_policy::bind(0) not_eq numa_policy::bind(1));
+    REQUIRE(numa_policy::bind(63).nodes() == std::uint64_t{1} << 63);
+    REQUIRE_THROWS_AS(numa_policy::bind(64), std::invalid_argument);
+}
+
+TEST_CASE("numa placed runtime_arrays", "[numa]")
+{
+    using bosswestfalen::numa_policy;
+    constexpr auto Large = std::size_t{1024} * 1024;
+
+    SECTION("first touch")
+    {
+        auto const rta = test_array(bosswestfalen::parallel, Large, 3);
+        REQUIRE(rta.get_allocator().policy() == numa_policy::first_touch());
+        REQUIRE(reinterpret_cast<std::uintptr_t>(rta.data()) % bosswestfalen::detail::page_size() == 0);
+        REQUIRE(rta.front() == 3);
+        REQUIRE(rta.back() == 3);
+    }
+
+    SECTION("bind and interleave")
+    {
+        for (auto const policy : {numa_policy::bind(0), numa_policy::interleave(), numa_policy::bind(63)})
+        {
+            auto rta = test_array(Large, bosswestfalen::value_initialise, policy);
+            REQUIRE(rta.get_allocator().policy() == policy);
+            REQUIRE(rta[Large / 2] == 0);
+            rta.fill(7);
+            REQUIRE(rta.back() == 7);
+
+            auto const copy = rta;
+            REQUIRE(copy == rta);
+        }
+    }
+
+    SECTION("small arrays")
+    {
+        auto const rta = test_array({1, 2, 3}, numa_policy::interleave());
+        REQUIRE(rta.size() == 3);
+        REQUIRE(rta[2] == 3);
+    }
+
+#if BOSSWESTFALEN_HAS_MBIND
+    SECTION("policies are applied to the pages")
+    {
+        auto const bound = test_array(Large, bosswestfalen::for_overwrite, numa_policy::bind(0));
+        REQUIRE(mode_of(bound.data()) == MPOL_BIND);
+
+        auto const interleaved = test_array(Large, bosswestfalen::for_overwrite, numa_policy::interleave());
+        REQUIRE(mode_of(interleaved.data()) == MPOL_INTERLEAVE);
+
+        auto const touched = test_array(Large, bosswestfalen::for_overwrite);
+        REQUIRE(mode_of(touched.data()) == MPOL_DEFAULT);
+    }
+
+    SECTION("pages are placed on the bound node")
+    {
+        if (bosswestfalen::numa_node_count() < 2)
+        {
+            WARN("only one NUMA node, placement is not checked");
+        }
+        else
+        {
+            auto last = 63u;
+            while ((bosswestfalen::numa_online_nodes() >> last & 1) == 0)
+            {
+                --last;
+            }
+            auto rta = test_array(Large, bosswestfalen::for_overwrite, numa_policy::bind(last));
+            rta.fill(1);
+            REQUIRE(node_of(rta.data()) == static_cast<int>(last));
+            REQUIRE(node_of(&rta.back()) == static_cast<int>(last));
+        }
+    }
+#endif
+}
@@ -0,0 +1,178 @@
+#include "bosswestfalen/packed_runtime_array.hpp"
+#include "catch/catch.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+
+namespace
+{
+/// deterministic values of Bits bits
+template <std::size_t Bits>
+auto make_values(std::size_t const n) -> bosswestfalen::runtime_array<std::uint64_t>
+{
+    return bosswestfalen::runtime_array<std::uint64_t>(n, bosswestfalen::generate, [](std::size_t const i) {
+        return (i * 0x9E3779B97F4A7C15ULL) & bosswestfalen::packed_runtime_array<Bits>::max_value;
+    });
+}
+
+/// pack, check single values and unpack again
+template <std::size_t Bits>
+void round_trip(std::size_t const n)
+{
+    auto const values = make_values<Bits>(n);
+    auto const packed = bosswestfalen::packed_runtime_array<Bits>(values);
+    REQUIRE(packed.size() == n);
+    for (auto i = std::size_t{0}; i < n; ++i)
+    {
+        REQUIRE(packed.get(i) == values[i]);
+    }
+    REQUIRE(packed.unpack() == values);
+
+    auto set_one_by_one = bosswestfalen::packed_runtime_array<Bits>(n);
+    for (auto i = std::size_t{0}; i < n; ++i)
+    {
+        set_one_by_one.set(i, values[i]);
+    }
+    REQUIRE(set_one_by_one == packed);
+}
+} // namespace
+
+
+TEST_CASE("creation of packed_runtime_arrays", "[packed]")
+{
+    using ids = bosswestfalen::packed_runtime_array<20>;
+
+    SECTION("empty")
+    {
+        auto const empty = ids{};
+        REQUIRE(empty.empty());
+        REQUIRE(empty.word_count() == 0);
+        REQUIRE(empty.unpack().empty());
+    }
+
+    SECTION("all 0, with one word of padding")
+    {
+        auto const zeros = ids(100);
+        REQUIRE(zeros.size() == 100);
+        REQUIRE(zeros.word_count() == 2000 / 64 + 1 + 1);
+        REQUIRE(zeros.get(99) == 0);
+    }
+
+    SECTION("filled with a value")
+    {
+        auto const filled = ids(1000, 12345);
+        for (auto i = std::size_t{0}; i < filled.size(); ++i)
+        {
+            REQUIRE(filled[i] == 12345);
+        }
+        REQUIRE(filled == ids(1000, 12345));
+        REQUIRE(filled not_eq ids(1000, 12344));
+        REQUIRE(filled not_eq ids(999, 12345));
+    }
+
+    SECTION("with initializer list, values are truncated")
+    {
+        auto const small = ids{1, ids::max_value, ids::max_value + 2};
+        REQUIRE(small.size() == 3);
+        REQUIRE(small[0] == 1);
+        REQUIRE(small[1] == (1 << 20) - 1);
+        REQUIRE(small[2] == 1);
+    }
+
+    SECTION("from 32 bit values")
+    {
+        auto const values = bosswestfalen::runtime_array<std::uint32_t>{7, 1 << 19, 42};
+        auto const packed = ids(values);
+        REQUIRE(packed == ids{7, 1 << 19, 42});
+        REQUIRE(packed.unpack<std::uint32_t>() == values);
+    }
+
+    SECTION("copy and move")
+    {
+        auto original = ids(70, 3);
+        auto const copy = original;
+        REQUIRE(copy == original);
+
+        auto moved = std::move(original);
+        REQUIRE(moved == copy);
+        REQUIRE(original.empty());
+
+        original = std::move(moved);
+        REQUIRE(original == copy);
+        REQUIRE(moved.empty());
+
+        swap(original, moved);
+        REQUIRE(moved == copy);
+        REQUIRE(original.empty());
+    }
+}
+
+
+TEST_CASE("element access of packed_runtime_arrays", "[packed]")
+{
+    using ids = bosswestfalen::packed_runtime_array<20>;
+    auto packed = ids(10);
+
+    SECTION("neighbours are not changed")
+    {
+        packed[3] = ids::max_value;
+        REQUIRE(packed[2] == 0);
+        REQUIRE(packed[3] == ids::max_value);
+        REQUIRE(packed[4] == 0);
+
+        packed[3] = 5;
+        packed[4] = packed[3];
+        REQUIRE(packed[3] == 5);
+        REQUIRE(packed[4] == 5);
+    }
+
+    SECTION("value spanning two words")
+    {
+        // bits 60 to 79
+        packed[3] = 0xABCDE;
+        REQUIRE(packed.data()[0] >> 60 == 0xE);
+        REQUIRE(packed.data()[1] == 0xABCD);
+        REQUIRE(packed.get(3) == 0xABCDE);
+    }
+
+    SECTION("with bounds checking")
+    {
+        packed.at(9) = 1;
+        REQUIRE(std::as_const(packed).at(9) == 1);
+        REQUIRE_THROWS_AS(packed.at(10), std::out_of_range);
+        REQUIRE_THROWS_AS(std::as_const(packed).at(10), std::out_of_range);
+    }
+
+    SECTION("partial unpack")
+    {
+        auto const values = make_values<20>(300);
+        auto const all = ids(values);
+        auto out = bosswestfalen::runtime_array<std::uint32_t>(200, 0u);
+        all.unpack(50, 200, out.data());
+        for (auto i = std::size_t{0}; i < out.size(); ++i)
+        {
+            REQUIRE(out[i] == values[50 + i]);
+        }
+    }
+}
+
+
+TEST_CASE("packing and unpacking of all widths", "[packed]")
+{
+    // 200 values: three full groups and a tail
+    round_trip<1>(200);
+    round_trip<3>(200);
+    round_trip<7>(200);
+    round_trip<8>(200);
+    round_trip<13>(200);
+    round_trip<20>(200);
+    round_trip<31>(200);
+    round_trip<32>(200);
+    round_trip<33>(200);
+    round_trip<47>(200);
+    round_trip<63>(200);
+    round_trip<64>(200);
+    round_trip<20>(64);
+    round_trip<20>(5);
+}
@@ -0,0 +1,173 @@
+#include "bosswestfalen/runtime_array.hpp"
+#include "catch/catch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using test_array = bosswestfalen::runtime_array<int>;
+
+
+namespace
+{
+/// use 4 threads, even for tiny arrays
+constexpr auto Policy = bosswestfalen::parallel_t{4, 0};
+
+/// element that throws when created from a negative value
+struct picky
+{
+    static inline std::atomic<int> alive{0};
+
+    explicit picky(int const v)
+        : value{v}
+    {
+        if (v < 0)
+        {
+            throw std::invalid_argument{"negative"};
+        }
+        ++alive;
+    }
+
+    picky(picky const& other)
+        : picky(other.value)
+    {
+    }
+
+    ~picky()
+    {
+        --alive;
+    }
+
+    int value;
+};
+
+/// number of allocations that succeed before operator new throws once, negative for never
+std::atomic<int> allocations_left{-1};
+} // namespace
+
+
+auto operator new(std::size_t const size) -> void*
+{
+    if (allocations_left.load() >= 0 and allocations_left.fetch_sub(1) == 0)
+    {
+        throw std::bad_alloc{};
+    }
+    if (auto* const p = std::malloc(size == 0 ? 1 : size))
+    {
+        return p;
+    }
+    throw std::bad_alloc{};
+}
+
+auto operator new(std::size_t const size, std::nothrow_t const&) noexcept -> void*
+{
+    try
+    {
+        return operator new(size);
+    }
+    catch (std::bad_alloc const&)
+    {
+        return nullptr;
+    }
+}
+
+// not inlined, or GCC pairs the free with a builtin operator new and warns
+[[gnu::noinline]] void operator delete(void* const p) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void* const p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+
+TEST_CASE("parallel construction, copy and fill", "[parallel]")
+{
+    SECTION("split into chunks")
+    {
+        REQUIRE(Policy.chunks(0, sizeof(int)) == 1);
+        REQUIRE(Policy.chunks(3, sizeof(int)) == 3);
+        REQUIRE(Policy.chunks(1000, sizeof(int)) == 4);
+        REQUIRE(bosswestfalen::parallel.chunks(10, sizeof(int)) == 1);
+
+        auto covered = std::vector<int>(10);
+        bosswestfalen::detail::parallel_chunks(covered.size(), 3,
+                                               [&covered](std::size_t, std::size_t const begin, std::size_t const end)
+                                               {
+                                                   for (auto i = begin; i < end; ++i)
+                                                   {
+                                                       ++covered[i];
+                                                   }
+                                               });
+        REQUIRE(std::all_of(covered.cbegin(), covered.cend(), [](auto const c) { return c == 1; }));
+    }
+
+    SECTION("thread state cannot be allocated")
+    {
+        auto covered = std::vector<int>(10);
+        // chunk errors, worker storage and the first worker succeed, the second worker fails
+        allocations_left = 3;
+        bosswestfalen::detail::parallel_chunks(covered.size(), 4,
+                                               [&covered](std::size_t, std::size_t const begin, std::size_t const end)
+                                               {
+                                                   for (auto i = begin; i < end; ++i)
+                                                   {
+                                                       ++covered[i];
+                                                   }
+                                               });
+        REQUIRE(allocations_left < 0);
+        allocations_left = -1;
+        REQUIRE(std::all_of(covered.cbegin(), covered.cend(), [](auto const c) { return c == 1; }));
+    }
+
+    SECTION("create with value")
+    {
+        auto const rta = test_array(Policy, 1001, 7);
+        REQUIRE(rta == test_array(1001, 7));
+
+        auto const empty = test_array(Policy, 0, 7);
+        REQUIRE(empty.empty());
+    }
+
+    SECTION("create with generator")
+    {
+        auto const rta = test_array(Policy, 1001, bosswestfalen::generate, [](std::size_t const i) { return static_cast<int>(i); });
+        auto expected = std::vector<int>(1001);
+        std::iota(expected.begin(), expected.end(), 0);
+        REQUIRE(std::equal(rta.cbegin(), rta.cend(), expected.cbegin(), expected.cend()));
+    }
+
+    SECTION("copy")
+    {
+        auto const src = std::vector<int>(999, 3);
+        auto const rta = test_array(Policy, src.data(), src.size());
+        REQUIRE(std::equal(rta.cbegin(), rta.cend(), src.cbegin(), src.cend()));
+
+        auto const strings = bosswestfalen::runtime_array<std::string>(100, std::string(40, 'x'));
+        auto const copy = bosswestfalen::runtime_array<std::string>(Policy, strings);
+        REQUIRE(copy == strings);
+    }
+
+    SECTION("fill")
+    {
+        auto rta = test_array(1003, 1);
+        rta.fill(Policy, 2);
+        REQUIRE(rta == test_array(1003, 2));
+    }
+
+    SECTION("exception in one thread")
+    {
+        auto const values = std::vector<int>{1, 2, 3, 4, 5, 6, -7, 8};
+        REQUIRE_THROWS_AS(bosswestfalen::runtime_array<picky>(Policy, values.size(), bosswestfalen::generate,
+                                                              [&values](std::size_t const i) { return picky{values[i]}; }),
+                          std::invalid_argument);
+        REQUIRE(picky::alive == 0);
+    }
+}
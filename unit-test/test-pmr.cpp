@@ -0,0 +1,111 @@
+#include "bosswestfalen/runtime_array.hpp"
+#include "catch/catch.hpp"
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory_resource>
+#include <string>
+
+
+namespace
+{
+/// memory_resource that counts the allocations forwarded to its upstream resource
+class counting_resource final : public std::pmr::memory_resource
+{
+  public:
+    int allocations{0};
+    int deallocations{0};
+
+  private:
+    void* do_allocate(std::size_t const bytes, std::size_t const alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* const p, std::size_t const bytes, std::size_t const alignment) override
+    {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+} // namespace
+
+
+TEST_CASE("polymorphic memory resources", "[pmr]")
+{
+    SECTION("array uses the given resource")
+    {
+        auto resource = counting_resource{};
+        {
+            auto const rta = bosswestfalen::pmr::runtime_array<int>(4, 1, &resource);
+            REQUIRE(rta.get_allocator().resource() == &resource);
+            REQUIRE(resource.allocations == 1);
+        }
+        REQUIRE(resource.deallocations == 1);
+    }
+
+    SECTION("monotonic buffer on the stack")
+    {
+        auto buffer = std::array<std::byte, 1024>{};
+        auto resource = std::pmr::monotonic_buffer_resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+        auto const a = bosswestfalen::pmr::runtime_array<int>(16, 7, &resource);
+        auto const b = bosswestfalen::pmr::runtime_array<int>({1, 2, 3}, &resource);
+
+        auto const begin = static_cast<void const*>(buffer.data());
+        auto const end = static_cast<void const*>(buffer.data() + buffer.size());
+        REQUIRE(std::less_equal<>{}(begin, a.data()));
+        REQUIRE(std::less<>{}(static_cast<void const*>(b.data()), end));
+        REQUIRE(a[15] == 7);
+        REQUIRE(b == bosswestfalen::pmr::runtime_array<int>{1, 2, 3});
+    }
+
+    SECTION("pool resource")
+    {
+        auto resource = std::pmr::unsynchronized_pool_resource{};
+        auto const rta = bosswestfalen::pmr::runtime_array<double>(8, 0.5, &resource);
+        REQUIRE(rta.get_allocator().resource() == &resource);
+        REQUIRE(rta.back() == 0.5);
+    }
+
+    SECTION("nested containers use the same resource")
+    {
+        using string_array = bosswestfalen::pmr::runtime_array<std::pmr::string>;
+        auto resource = counting_resource{};
+        auto const long_text = std::pmr::string(64, 'x');
+
+        SECTION("default constructed elements")
+        {
+            auto const rta = string_array(3, &resource);
+            for (auto const& s : rta)
+            {
+                REQUIRE(s.get_allocator().resource() == &resource);
+            }
+        }
+
+        SECTION("copied elements")
+        {
+            auto const rta = string_array(2, long_text, &resource);
+            REQUIRE(rta[0] == long_text);
+            REQUIRE(rta[1].get_allocator().resource() == &resource);
+            REQUIRE(resource.allocations == 3);
+        }
+
+        SECTION("copy with other resource")
+        {
+            auto other = counting_resource{};
+            auto const src = string_array({long_text}, &resource);
+            auto const rta = string_array(src, &other);
+            REQUIRE(rta.front().get_allocator().resource() == &other);
+            REQUIRE(other.allocations == 2);
+        }
+
+        REQUIRE(resource.allocations == resource.deallocations);
+    }
+}
@@ -0,0 +1,198 @@
+#include "bosswestfalen/pool_allocator.hpp"
+#include "catch/catch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <set>
+#include <thread>
+#include <vector>
+
+
+using test_array = bosswestfalen::pool_runtime_array<int>;
+using bosswestfalen::slab_pool;
+
+
+namespace
+{
+/// sum of hits and misses of size class index
+auto requests(std::size_t const index)
+{
+    auto const stats = slab_pool::instance().statistics()[index];
+    return stats.hits + stats.misses;
+}
+} // namespace
+
+
+TEST_CASE("slab pool for small runtime_arrays", "[pool]")
+{
+    SECTION("size classes")
+    {
+        REQUIRE(slab_pool::size_class(1) == 0);
+        REQUIRE(slab_pool::size_class(16) == 0);
+        REQUIRE(slab_pool::size_class(17) == 1);
+        REQUIRE(slab_pool::size_class(4096) == slab_pool::class_count - 1);
+        REQUIRE(slab_pool::is_pooled(4096, alignof(int)));
+        REQUIRE_FALSE(slab_pool::is_pooled(4097, alignof(int)));
+    }
+
+    SECTION("works with the runtime_array ctors")
+    {
+        auto const before = requests(slab_pool::size_class(4 * sizeof(int)));
+
+        auto const a = test_array(4);
+        auto const b = test_array(4, 7);
+        auto const c = b;
+        auto const d = test_array{1, 2, 3, 4};
+
+        REQUIRE(c == b);
+        REQUIRE(d.back() == 4);
+        REQUIRE(requests(slab_pool::size_class(4 * sizeof(int))) == before + 4);
+    }
+
+    SECTION("freed blocks are reused")
+    {
+        auto const index = slab_pool::size_class(32 * sizeof(int));
+        void const* first = nullptr;
+        {
+            auto const rta = test_array(32, 1);
+            first = rta.data();
+        }
+        auto const hits = slab_pool::instance().statistics()[index].hits;
+
+        auto const rta = test_array(32, 2);
+        REQUIRE(rta.data() == first);
+        REQUIRE(slab_pool::instance().statistics()[index].hits == hits + 1);
+    }
+
+    SECTION("large arrays bypass the pool")
+    {
+        auto const before = slab_pool::instance().statistics();
+        auto const rta = test_array(10'000, 3);
+        REQUIRE(rta[9'999] == 3);
+        auto const after = slab_pool::instance().statistics();
+        for (auto i = std::size_t{0}; i < slab_pool::class_count; ++i)
+        {
+            REQUIRE(before[i].hits == after[i].hits);
+            REQUIRE(before[i].misses == after[i].misses);
+        }
+    }
+
+    SECTION("blocks can be freed by other threads")
+    {
+        constexpr auto Threads = 4;
+        constexpr auto Arrays = 1000;
+
+        auto arrays = std::vector<test_array>{};
+        for (auto i = 0; i < Threads * Arrays; ++i)
+        {
+            arrays.emplace_back(8, i);
+        }
+
+        auto errors = std::atomic<int>{0};
+        auto workers = std::vector<std::thread>{};
+        for (auto t = 0; t < Threads; ++t)
+        {
+            workers.emplace_back([&arrays, &errors, t]
+                                 {
+                                     for (auto i = t * Arrays; i < (t + 1) * Arrays; ++i)
+                                     {
+                                         arrays[i] = test_array{};
+                                     }
+                                     for (auto i = 0; i < Arrays; ++i)
+                                     {
+                                         auto const rta = test_array(8, i);
+                                         if (rta.back() not_eq i)
+                                         {
+                                             ++errors;
+                                         }
+                                     }
+                                 });
+        }
+        for (auto& w : workers)
+        {
+            w.join();
+        }
+
+        REQUIRE(errors == 0);
+        REQUIRE(std::all_of(arrays.cbegin(), arrays.cend(), [](auto const& rta) { return rta.empty(); }));
+
+        auto const stats = slab_pool::instance().statistics()[slab_pool::size_class(8 * sizeof(int))];
+        REQUIRE(stats.hits + stats.misses >= 2 * Threads * Arrays);
+    }
+
+    SECTION("blocks of an exited thread are reused in batches")
+    {
+        // a size class no other section uses
+        constexpr auto Bytes = std::size_t{2048};
+        constexpr auto Blocks = 1000;
+        auto alloc = bosswestfalen::pool_allocator<std::byte>{};
+
+        auto freed = std::set<std::byte*>{};
+        std::thread{[&]
+                    {
+                        auto blocks = std::vector<std::byte*>(Blocks);
+                        for (auto& block : blocks)
+                        {
+                            block = alloc.allocate(Bytes);
+                        }
+                        for (auto const block : blocks)
+                        {
+                            alloc.deallocate(block, Bytes);
+                            freed.insert(block);
+                        }
+                    }}
+            .join();
+
+        auto reused = 0;
+        auto blocks = std::vector<std::byte*>(Blocks);
+        for (auto& block : blocks)
+        {
+            block = alloc.allocate(Bytes);
+            reused += static_cast<int>(freed.count(block));
+        }
+        REQUIRE(reused == Blocks);
+        for (auto const block : blocks)
+        {
+            alloc.deallocate(block, Bytes);
+        }
+    }
+
+    SECTION("the depot hands out each block once under contention")
+    {
+        // a size class no other section uses, more blocks than a cache holds
+        constexpr auto Bytes = std::size_t{1024};
+        constexpr auto Threads = 4;
+        constexpr auto Blocks = 200;
+        constexpr auto Rounds = 200;
+        auto alloc = bosswestfalen::pool_allocator<int>{};
+
+        auto errors = std::atomic<int>{0};
+        auto workers = std::vector<std::thread>{};
+        for (auto t = 0; t < Threads; ++t)
+        {
+            workers.emplace_back([&alloc, &errors, t]
+                                 {
+                                     auto blocks = std::vector<int*>(Blocks);
+                                     for (auto r = 0; r < Rounds; ++r)
+                                     {
+                                         for (auto& block : blocks)
+                                         {
+                                             block = alloc.allocate(Bytes / sizeof(int));
+                                             block[1] = t;
+                                         }
+                                         for (auto const block : blocks)
+                                         {
+                                             errors += static_cast<int>(block[1] not_eq t);
+                                             alloc.deallocate(block, Bytes / sizeof(int));
+                                         }
+                                     }
+                                 });
+        }
+        for (auto& w : workers)
+        {
+            w.join();
+        }
+
+        REQUIRE(errors == 0);
+    }
+}
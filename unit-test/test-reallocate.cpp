@@ -0,0 +1,222 @@
+#include "bosswestfalen/huge_page_allocator.hpp"
+#include "bosswestfalen/page_allocator.hpp"
+#include "bosswestfalen/runtime_array.hpp"
+#include "catch/catch.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+namespace
+{
+/// element whose default ctor throws once default_ctors_left reaches 0
+struct throwing_default
+{
+    static inline int default_ctors_left{-1};
+
+    throwing_default()
+    {
+        if (default_ctors_left-- == 0)
+        {
+            throw std::runtime_error{"default ctor"};
+        }
+    }
+
+    throwing_default(int const v)
+        : value{v}
+    {
+    }
+
+    int value{0};
+};
+
+/// element that is moved, its default ctor throws once default_ctors_left reaches 0
+struct throwing_text
+{
+    static inline int default_ctors_left{-1};
+
+    throwing_text()
+    {
+        if (default_ctors_left-- == 0)
+        {
+            throw std::runtime_error{"default ctor"};
+        }
+    }
+
+    throwing_text(char const* const t)
+        : text{t}
+    {
+    }
+
+    std::string text{};
+};
+
+/// element that is copied, as its move ctor may throw; its copy ctor throws once copies_left reaches 0
+struct throwing_copy
+{
+    static inline int copies_left{-1};
+
+    throwing_copy() = default;
+
+    throwing_copy(char const* const t)
+        : text{t}
+    {
+    }
+
+    throwing_copy(throwing_copy const& other)
+        : text{other.text}
+    {
+        if (copies_left-- == 0)
+        {
+            throw std::runtime_error{"copy ctor"};
+        }
+    }
+
+    throwing_copy(throwing_copy&& other) noexcept(false)
+        : text{std::move(other.text)}
+    {
+    }
+
+    std::string text{};
+};
+} // namespace
+
+
+TEST_CASE("reallocate", "[reallocate]")
+{
+    SECTION("trivial elements")
+    {
+        auto rta = bosswestfalen::runtime_array<int>{1, 2, 3};
+
+        rta.reallocate(5);
+        REQUIRE(rta.size() == 5);
+        REQUIRE(rta[2] == 3);
+
+        rta.reallocate(2);
+        REQUIRE(rta == bosswestfalen::runtime_array<int>{1, 2});
+
+        rta.reallocate(0);
+        REQUIRE(rta.empty());
+        REQUIRE(rta.data() == nullptr);
+
+        rta.reallocate(1);
+        REQUIRE(rta.size() == 1);
+    }
+
+    SECTION("elements that are moved")
+    {
+        using strings = bosswestfalen::runtime_array<std::string>;
+        auto rta = strings{std::string(100, 'a'), "b"};
+
+        rta.reallocate(3);
+        REQUIRE(rta[0] == std::string(100, 'a'));
+        REQUIRE(rta[1] == "b");
+        REQUIRE(rta[2].empty());
+
+        rta.reallocate(1);
+        REQUIRE(rta == strings{std::string(100, 'a')});
+    }
+
+    SECTION("trivially relocatable elements keep their memory")
+    {
+        using inner = bosswestfalen::runtime_array<int>;
+        auto rta = bosswestfalen::runtime_array<inner>{inner{1, 2}, inner{3}};
+        auto const data = rta[0].data();
+
+        rta.reallocate(4);
+        REQUIRE(rta[0].data() == data);
+        REQUIRE(rta[1] == inner{3});
+        REQUIRE(rta[3].empty());
+
+        rta.reallocate(1);
+        REQUIRE(rta[0].data() == data);
+    }
+
+    SECTION("array is unchanged if a new element throws")
+    {
+        auto rta = bosswestfalen::runtime_array<throwing_default>{1, 2};
+        auto const data = rta.data();
+
+        throwing_default::default_ctors_left = 1;
+        REQUIRE_THROWS_AS(rta.reallocate(4), std::runtime_error);
+        throwing_default::default_ctors_left = -1;
+
+        REQUIRE(rta.size() == 2);
+        REQUIRE(rta.data() == data);
+        REQUIRE(rta[1].value == 2);
+    }
+
+    SECTION("moved elements are unchanged if a new element throws")
+    {
+        auto rta = bosswestfalen::runtime_array<throwing_text>{"long text that is not stored inline", "b"};
+
+        throwing_text::default_ctors_left = 1;
+        REQUIRE_THROWS_AS(rta.reallocate(4), std::runtime_error);
+        throwing_text::default_ctors_left = -1;
+
+        REQUIRE(rta.size() == 2);
+        REQUIRE(rta[0].text == "long text that is not stored inline");
+        REQUIRE(rta[1].text == "b");
+    }
+
+    SECTION("copied elements are unchanged if a copy throws")
+    {
+        auto rta = bosswestfalen::runtime_array<throwing_copy>{"long text that is not stored inline", "b", "c"};
+
+        throwing_copy::copies_left = 1;
+        REQUIRE_THROWS_AS(rta.reallocate(4), std::runtime_error);
+        throwing_copy::copies_left = -1;
+
+        REQUIRE(rta.size() == 3);
+        REQUIRE(rta[0].text == "long text that is not stored inline");
+        REQUIRE(rta[2].text == "c");
+
+        rta.reallocate(2);
+        REQUIRE(rta.size() == 2);
+        REQUIRE(rta[1].text == "b");
+    }
+}
+
+TEST_CASE("reallocate mapped memory", "[reallocate]")
+{
+    SECTION("pages are remapped")
+    {
+        using test_array = bosswestfalen::page_runtime_array<std::uint64_t>;
+        constexpr auto Large = std::size_t{1024} * 1024;
+
+        auto rta = test_array(Large, 7);
+        rta.back() = 8;
+
+        rta.reallocate(2 * Large);
+        REQUIRE(rta.size() == 2 * Large);
+        REQUIRE(rta[0] == 7);
+        REQUIRE(rta[Large - 1] == 8);
+        REQUIRE(rta.back() == 0);
+
+        rta.reallocate(16);
+        REQUIRE_FALSE(test_array::allocator_type::uses_pages(rta.size()));
+        REQUIRE(rta.back() == 7);
+
+        rta.reallocate(Large);
+        REQUIRE(rta[15] == 7);
+    }
+
+    SECTION("huge pages stay aligned")
+    {
+        using test_array = bosswestfalen::huge_page_runtime_array<std::uint64_t>;
+        constexpr auto Large = bosswestfalen::huge_page_size / sizeof(std::uint64_t);
+
+        auto rta = test_array(Large, 1);
+        rta.back() = 2;
+
+        rta.reallocate(3 * Large);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(rta.data()) % bosswestfalen::huge_page_size == 0);
+        REQUIRE(rta.front() == 1);
+        REQUIRE(rta[Large - 1] == 2);
+
+        rta.reallocate(Large + 1);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(rta.data()) % bosswestfalen::huge_page_size == 0);
+        REQUIRE(rta[Large - 1] == 2);
+    }
+}
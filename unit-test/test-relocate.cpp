@@ -0,0 +1,72 @@
+#include "bosswestfalen/runtime_array.hpp"
+#include "bosswestfalen/small_runtime_array.hpp"
+#include "catch/catch.hpp"
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+
+using test_array = bosswestfalen::runtime_array<int>;
+
+
+TEST_CASE("moves do not throw", "[relocate]")
+{
+    STATIC_REQUIRE(std::is_nothrow_move_constructible_v<test_array>);
+    STATIC_REQUIRE(std::is_nothrow_move_assignable_v<test_array>);
+    STATIC_REQUIRE(std::is_nothrow_move_constructible_v<bosswestfalen::runtime_array<std::string>>);
+
+    SECTION("std::vector moves its runtime_arrays on growth")
+    {
+        auto arrays = std::vector<test_array>{};
+        arrays.emplace_back(test_array{1, 2, 3});
+        auto const data = arrays.front().data();
+
+        arrays.resize(arrays.capacity() + 1);
+        REQUIRE(arrays.front().data() == data);
+        REQUIRE(arrays.front() == test_array{1, 2, 3});
+    }
+}
+
+TEST_CASE("trivially relocatable", "[relocate]")
+{
+    STATIC_REQUIRE(bosswestfalen::is_trivially_relocatable_v<int>);
+    STATIC_REQUIRE(bosswestfalen::is_trivially_relocatable_v<test_array>);
+    STATIC_REQUIRE(bosswestfalen::is_trivially_relocatable_v<bosswestfalen::runtime_array<std::string>>);
+    STATIC_REQUIRE_FALSE(bosswestfalen::is_trivially_relocatable_v<std::string>);
+    STATIC_REQUIRE_FALSE(bosswestfalen::is_trivially_relocatable_v<bosswestfalen::small_runtime_array<int, 4>>);
+
+    SECTION("runtime_arrays are relocated with memcpy")
+    {
+        auto storage = std::allocator<test_array>{};
+        auto const src = storage.allocate(2);
+        auto const dest = storage.allocate(2);
+        ::new (static_cast<void*>(src)) test_array{1, 2};
+        ::new (static_cast<void*>(src + 1)) test_array{3};
+        auto const data = src->data();
+
+        REQUIRE(bosswestfalen::uninitialized_relocate_n(src, 2, dest) == dest + 2);
+        REQUIRE(dest[0].data() == data);
+        REQUIRE(dest[0] == test_array{1, 2});
+        REQUIRE(dest[1] == test_array{3});
+
+        std::destroy_n(dest, 2);
+        storage.deallocate(dest, 2);
+        storage.deallocate(src, 2);
+    }
+
+    SECTION("other types are moved and destroyed")
+    {
+        auto storage = std::allocator<std::string>{};
+        auto const src = storage.allocate(1);
+        auto const dest = storage.allocate(1);
+        ::new (static_cast<void*>(src)) std::string(100, 'x');
+
+        bosswestfalen::uninitialized_relocate_n(src, 1, dest);
+        REQUIRE(*dest == std::string(100, 'x'));
+
+        std::destroy_at(dest);
+        storage.deallocate(dest, 1);
+        storage.deallocate(src, 1);
+    }
+}
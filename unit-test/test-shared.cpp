@@ -0,0 +1,238 @@
+#include "bosswestfalen/shared_runtime_array.hpp"
+#include "catch/catch.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+using test_shared = bosswestfalen::shared_runtime_array<int>;
+
+/// memory_resource that counts the allocations forwarded to its upstream resource
+class counting_resource final : public std::pmr::memory_resource
+{
+  public:
+    int allocations{0};
+    int deallocations{0};
+
+  private:
+    void* do_allocate(std::size_t const bytes, std::size_t const alignment) override
+    {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* const p, std::size_t const bytes, std::size_t const alignment) override
+    {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+/// element whose constructor throws for the third element
+struct throwing
+{
+    static inline int alive = 0;
+
+    explicit throwing(std::size_t const i)
+    {
+        if (i == 2)
+        {
+            throw std::runtime_error{"third"};
+        }
+        ++alive;
+    }
+
+    throwing(throwing const&) = delete;
+
+    ~throwing()
+    {
+        --alive;
+    }
+};
+
+/// element with an alignment larger than the header
+struct alignas(64) over_aligned
+{
+    int value;
+};
+} // namespace
+
+
+TEST_CASE("creation of shared_runtime_arrays", "[shared]")
+{
+    SECTION("empty")
+    {
+        auto const empty = test_shared{};
+        REQUIRE(empty.empty());
+        REQUIRE(empty.data() == nullptr);
+        REQUIRE(empty.use_count() == 0);
+        REQUIRE(empty.begin() == empty.end());
+        REQUIRE(sizeof(empty) == sizeof(void*));
+    }
+
+    SECTION("value-initialised, with value and generated")
+    {
+        auto const zeros = test_shared(3, bosswestfalen::value_initialise);
+        REQUIRE(zeros == test_shared{0, 0, 0});
+
+        auto const sevens = test_shared(3, 7);
+        REQUIRE(sevens == test_shared{7, 7, 7});
+
+        auto const squares = test_shared(4, bosswestfalen::generate, [](std::size_t const i) { return static_cast<int>(i * i); });
+        REQUIRE(squares == test_shared{0, 1, 4, 9});
+    }
+
+    SECTION("copy of a runtime_array")
+    {
+        auto const array = bosswestfalen::runtime_array<int>{1, 2, 3};
+        auto const shared = test_shared(array);
+        REQUIRE(std::equal(shared.begin(), shared.end(), array.begin(), array.end()));
+        REQUIRE(array.size() == 3);
+    }
+
+    SECTION("freeze a runtime_array")
+    {
+        auto array = bosswestfalen::runtime_array<std::string>{"a", "long string that is not stored inline", "c"};
+        auto const shared = freeze(std::move(array));
+        REQUIRE(array.empty());
+        REQUIRE(shared.size() == 3);
+        REQUIRE(shared[1] == "long string that is not stored inline");
+        REQUIRE(shared.back() == "c");
+    }
+
+    SECTION("elements are aligned")
+    {
+        auto const shared = bosswestfalen::shared_runtime_array<over_aligned>(3, over_aligned{5});
+        REQUIRE(reinterpret_cast<std::uintptr_t>(shared.data()) % 64 == 0);
+        REQUIRE(shared[2].value == 5);
+    }
+
+    SECTION("constructed elements are destroyed, if one throws")
+    {
+        using throwing_shared = bosswestfalen::shared_runtime_array<throwing>;
+        REQUIRE_THROWS_AS(throwing_shared(4, bosswestfalen::generate, [](std::size_t const i) { return i; }), std::runtime_error);
+        REQUIRE(throwing::alive == 0);
+    }
+}
+
+
+TEST_CASE("sharing of shared_runtime_arrays", "[shared]")
+{
+    auto const original = test_shared{1, 2, 3};
+    REQUIRE(original.use_count() == 1);
+
+    SECTION("copies share the elements")
+    {
+        auto copy = original;
+        REQUIRE(copy.shares_with(original));
+        REQUIRE(copy.data() == original.data());
+        REQUIRE(original.use_count() == 2);
+
+        auto moved = std::move(copy);
+        REQUIRE(copy.empty());
+        REQUIRE(original.use_count() == 2);
+
+        moved = test_shared{4};
+        REQUIRE(original.use_count() == 1);
+        REQUIRE(moved.use_count() == 1);
+    }
+
+    SECTION("assignment")
+    {
+        auto other = test_shared{4, 5};
+        other = original;
+        REQUIRE(other.shares_with(original));
+        other = other;
+        REQUIRE(original.use_count() == 2);
+
+        swap(other, other);
+        auto empty = test_shared{};
+        swap(other, empty);
+        REQUIRE(other.empty());
+        REQUIRE(empty == original);
+    }
+
+    SECTION("element access")
+    {
+        REQUIRE(original.front() == 1);
+        REQUIRE(original.at(2) == 3);
+        REQUIRE_THROWS_AS(original.at(3), std::out_of_range);
+        REQUIRE(*original.rbegin() == 3);
+        REQUIRE(std::accumulate(original.cbegin(), original.cend(), 0) == 6);
+    }
+
+    SECTION("comparison")
+    {
+        REQUIRE(original == test_shared{1, 2, 3});
+        REQUIRE(original not_eq test_shared{1, 2});
+        REQUIRE(original < test_shared{1, 2, 4});
+        REQUIRE(original > test_shared{1, 2});
+        REQUIRE(original <= original);
+        REQUIRE(original >= test_shared{});
+    }
+
+    SECTION("comparison like runtime_array, NaN is not equal to itself")
+    {
+        auto const nan = std::numeric_limits<double>::quiet_NaN();
+        auto const array = bosswestfalen::runtime_array<double>{1.0, nan};
+        auto const shared = bosswestfalen::shared_runtime_array<double>(array);
+        auto const copy = shared;
+        REQUIRE((array == array) == (shared == copy));
+        REQUIRE_FALSE(shared == copy);
+        REQUIRE(shared not_eq shared);
+    }
+
+    SECTION("copies in several threads")
+    {
+        auto const big = test_shared(1000, 1);
+        auto sums = std::vector<int>(8);
+        auto workers = std::vector<std::thread>{};
+        for (auto& sum : sums)
+        {
+            workers.emplace_back([big, &sum] {
+                for (auto i = 0; i < 1000; ++i)
+                {
+                    auto const copy = big;
+                    sum += copy[static_cast<std::size_t>(i)];
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        REQUIRE(big.use_count() == 1);
+        REQUIRE(std::all_of(sums.begin(), sums.end(), [](int const s) { return s == 1000; }));
+    }
+}
+
+
+TEST_CASE("shared_runtime_arrays need a single allocation", "[shared]")
+{
+    auto resource = counting_resource{};
+    {
+        auto const shared = bosswestfalen::shared_runtime_array<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>(
+            2, std::pmr::string{"x"}, &resource);
+        REQUIRE(resource.allocations == 1);
+        REQUIRE(shared.get_allocator().resource() == &resource);
+
+        auto const copies = std::vector(10, shared);
+        REQUIRE(resource.allocations == 1);
+        REQUIRE(shared.use_count() == 11);
+    }
+    REQUIRE(resource.deallocations == 1);
+}
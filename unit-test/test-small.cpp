@@ -0,0 +1,140 @@
+#include "bosswestfalen/small_runtime_array.hpp"
+#include "catch/catch.hpp"
+#include <string>
+#include <vector>
+
+
+using test_array = bosswestfalen::small_runtime_array<int, 4>;
+
+
+namespace
+{
+/// check whether the elements of rta are stored inside of rta
+template <typename A>
+auto stored_inside(A const& rta)
+{
+    auto const begin = reinterpret_cast<char const*>(&rta);
+    auto const p = reinterpret_cast<char const*>(rta.data());
+    return (begin <= p) and (p < begin + sizeof(rta));
+}
+} // namespace
+
+
+TEST_CASE("small runtime_array", "[small]")
+{
+    SECTION("small arrays are stored inline")
+    {
+        auto const empty = test_array{};
+        auto const small = test_array(4, 1);
+        REQUIRE(empty.is_inline());
+        REQUIRE(small.is_inline());
+        REQUIRE(stored_inside(small));
+        REQUIRE(small == test_array{1, 1, 1, 1});
+    }
+
+    SECTION("large arrays are stored on the heap")
+    {
+        auto const large = test_array(5, 1);
+        REQUIRE_FALSE(large.is_inline());
+        REQUIRE_FALSE(stored_inside(large));
+        REQUIRE(large.size() == 5);
+    }
+
+    SECTION("same api as runtime_array")
+    {
+        auto const src = std::vector{1, 2, 3};
+        auto rta = test_array(src.cbegin(), src.cend());
+        REQUIRE(rta == test_array(src.data(), src.size()));
+        REQUIRE(rta.at(2) == 3);
+        REQUIRE_THROWS_AS(rta.at(3), std::out_of_range);
+        REQUIRE(rta.front() == 1);
+        REQUIRE(rta.back() == 3);
+        REQUIRE(std::distance(rta.rbegin(), rta.rend()) == 3);
+
+        rta.fill(7);
+        REQUIRE(rta == test_array{7, 7, 7});
+        REQUIRE(test_array{1, 2} < rta);
+        REQUIRE(rta not_eq test_array{7, 7});
+    }
+
+    SECTION("copy and move")
+    {
+        SECTION("inline")
+        {
+            auto src = test_array{1, 2, 3};
+            auto const copy = src;
+            REQUIRE(copy == src);
+            REQUIRE(stored_inside(copy));
+
+            auto const moved = std::move(src);
+            REQUIRE(moved == copy);
+            REQUIRE(src.empty());
+        }
+
+        SECTION("heap")
+        {
+            auto src = test_array{1, 2, 3, 4, 5};
+            auto const copy = src;
+            REQUIRE(copy == src);
+            REQUIRE(copy.data() not_eq src.data());
+
+            auto const data = src.data();
+            auto const moved = std::move(src);
+            REQUIRE(moved.data() == data);
+            REQUIRE(src.empty());
+        }
+
+        SECTION("non-trivial elements")
+        {
+            using string_array = bosswestfalen::small_runtime_array<std::string, 2>;
+            auto src = string_array{"a", std::string(100, 'b')};
+            auto const copy = src;
+            auto const moved = std::move(src);
+            REQUIRE(moved == copy);
+            REQUIRE(src.empty());
+
+            auto target = string_array{"x", "y", "z"};
+            target = moved;
+            REQUIRE(target == copy);
+            REQUIRE(target.is_inline());
+        }
+    }
+
+    SECTION("assign and swap between inline and heap storage")
+    {
+        auto const small_values = test_array{1, 2};
+        auto const large_values = test_array{1, 2, 3, 4, 5, 6};
+        auto small = small_values;
+        auto large = large_values;
+
+        SECTION("copy assign")
+        {
+            small = large_values;
+            large = small_values;
+            REQUIRE(small == large_values);
+            REQUIRE(large == small_values);
+        }
+
+        SECTION("move assign")
+        {
+            small = std::move(large);
+            REQUIRE(small == large_values);
+            REQUIRE(large.empty());
+
+            small = test_array{9};
+            REQUIRE(small == test_array{9});
+        }
+
+        SECTION("swap")
+        {
+            swap(small, large);
+            REQUIRE(small == large_values);
+            REQUIRE(large == small_values);
+
+            auto other = test_array{3};
+            swap(large, other);
+            REQUIRE(large == test_array{3});
+            REQUIRE(other == small_values);
+        }
+    }
+}
@@ -0,0 +1,173 @@
+#include "bosswestfalen/runtime_soa.hpp"
+#include "catch/catch.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+
+using test_soa = bosswestfalen::runtime_soa<int, double, std::string>;
+
+
+namespace
+{
+/// element whose fourth construction throws
+struct throwing
+{
+    static inline int alive{0};
+
+    throwing()
+    {
+        if (alive == 3)
+        {
+            throw std::runtime_error{"ctor"};
+        }
+        ++alive;
+    }
+
+    ~throwing()
+    {
+        --alive;
+    }
+};
+} // namespace
+
+
+TEST_CASE("creation of runtime_soas", "[soa]")
+{
+    SECTION("empty")
+    {
+        auto const soa = test_soa{};
+        REQUIRE(soa.empty());
+        REQUIRE(soa.begin() == soa.end());
+        REQUIRE(soa.column<0>().empty());
+    }
+
+    SECTION("with size")
+    {
+        auto const soa = test_soa(5);
+        REQUIRE(soa.size() == 5);
+        REQUIRE(soa.column<2>().size() == 5);
+        REQUIRE(soa.column<2>()[4].empty());
+    }
+
+    SECTION("with value")
+    {
+        auto const soa = test_soa(3, {1, 2.5, "x"});
+        REQUIRE(soa[2] == std::make_tuple(1, 2.5, std::string{"x"}));
+    }
+
+    SECTION("with rows")
+    {
+        auto const soa = test_soa{{1, 1.5, "a"}, {2, 2.5, "b"}};
+        REQUIRE(soa.size() == 2);
+        REQUIRE(std::get<2>(soa[1]) == "b");
+    }
+
+    SECTION("columns are aligned")
+    {
+        auto const soa = bosswestfalen::runtime_soa<char, double, std::uint16_t>(7);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(soa.data<0>()) % decltype(soa)::alignment == 0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(soa.data<1>()) % decltype(soa)::alignment == 0);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(soa.data<2>()) % decltype(soa)::alignment == 0);
+    }
+
+    SECTION("copy and move")
+    {
+        auto soa = test_soa{{1, 1.5, "a"}, {2, 2.5, "b"}};
+        auto copy = soa;
+        REQUIRE(copy == soa);
+        REQUIRE(copy.data<0>() not_eq soa.data<0>());
+
+        auto const moved = std::move(soa);
+        REQUIRE(moved == copy);
+        REQUIRE(soa.empty());
+
+        copy = test_soa(1);
+        REQUIRE(copy.size() == 1);
+        REQUIRE(copy not_eq moved);
+
+        swap(copy, soa);
+        REQUIRE(copy.empty());
+        REQUIRE(soa.size() == 1);
+    }
+
+    SECTION("exception safety")
+    {
+        REQUIRE_THROWS_AS((bosswestfalen::runtime_soa<std::string, throwing>(5)), std::runtime_error);
+        REQUIRE(throwing::alive == 0);
+    }
+}
+
+TEST_CASE("access of runtime_soas", "[soa]")
+{
+    auto soa = test_soa{{1, 1.5, "a"}, {2, 2.5, "b"}, {3, 3.5, "c"}};
+
+    SECTION("rows")
+    {
+        auto [i, d, s] = soa[1];
+        i = 20;
+        d = 0.5;
+        s = "z";
+        REQUIRE(soa.data<0>()[1] == 20);
+        REQUIRE(soa.column<1>()[1] == 0.5);
+        REQUIRE(std::get<2>(soa.at(1)) == "z");
+
+        soa[0] = std::make_tuple(10, 10.5, "y");
+        REQUIRE(soa[0] == std::make_tuple(10, 10.5, std::string{"y"}));
+
+        REQUIRE_THROWS_AS(soa.at(3), std::out_of_range);
+    }
+
+    SECTION("columns")
+    {
+        auto const ints = soa.column<0>();
+        REQUIRE(std::accumulate(ints.begin(), ints.end(), 0) == 6);
+
+        for (auto& d : soa.column<1>())
+        {
+            d *= 2;
+        }
+        REQUIRE(soa.column<1>()[2] == 7.0);
+
+        bosswestfalen::soa_column<int const> const read_only = soa.column<0>();
+        REQUIRE(read_only.data() == soa.data<0>());
+    }
+
+    SECTION("row iterators")
+    {
+        // proxy references are only allowed for input iterators
+        STATIC_REQUIRE(std::is_same_v<std::iterator_traits<test_soa::iterator>::iterator_category, std::input_iterator_tag>);
+        STATIC_REQUIRE(std::is_same_v<std::iterator_traits<test_soa::const_iterator>::iterator_category, std::input_iterator_tag>);
+
+        REQUIRE(soa.end() - soa.begin() == 3);
+        REQUIRE(std::get<0>(*(soa.begin() + 2)) == 3);
+        REQUIRE(std::get<2>(soa.cbegin()[1]) == "b");
+
+        auto sum = 0;
+        for (auto const& [i, d, s] : std::as_const(soa))
+        {
+            sum += i;
+            static_cast<void>(d);
+            static_cast<void>(s);
+        }
+        REQUIRE(sum == 6);
+
+        auto const found = std::find_if(soa.begin(), soa.end(), [](auto const& row) { return std::get<2>(row) == "c"; });
+        REQUIRE(found - soa.begin() == 2);
+
+        test_soa::const_iterator it = soa.begin();
+        REQUIRE(it == soa.cbegin());
+        REQUIRE(it < soa.cend());
+    }
+
+    SECTION("fill")
+    {
+        soa.fill({7, 0.0, "f"});
+        REQUIRE(soa[2] == std::make_tuple(7, 0.0, std::string{"f"}));
+    }
+}
@@ -0,0 +1,238 @@
+#include "bosswestfalen/runtime_mdarray.hpp"
+#include "bosswestfalen/tiled_layouts.hpp"
+#include "catch/catch.hpp"
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+
+using bosswestfalen::dextents;
+using bosswestfalen::layout_left;
+using bosswestfalen::layout_morton;
+using bosswestfalen::layout_right;
+using bosswestfalen::layout_tiled;
+using bosswestfalen::runtime_array2d;
+
+
+namespace
+{
+/// check that the mapping of a rows x cols matrix is unique and within its span
+template <typename Mapping>
+bool is_unique_within_span(Mapping const& m, std::size_t const rows, std::size_t const cols)
+{
+    auto offsets = std::set<std::size_t>{};
+    for (auto i = std::size_t{0}; i < rows; ++i)
+    {
+        for (auto j = std::size_t{0}; j < cols; ++j)
+        {
+            auto const offset = m(i, j);
+            if (offset >= m.required_span_size() or not offsets.insert(offset).second)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// matrix with element (i, j) = 100 * i + j
+template <typename Layout>
+auto numbered(std::size_t const rows, std::size_t const cols) -> runtime_array2d<int, Layout>
+{
+    auto matrix = runtime_array2d<int, Layout>(rows, cols);
+    for (auto i = std::size_t{0}; i < rows; ++i)
+    {
+        for (auto j = std::size_t{0}; j < cols; ++j)
+        {
+            matrix(i, j) = static_cast<int>(100 * i + j);
+        }
+    }
+    return matrix;
+}
+} // namespace
+
+
+TEST_CASE("tiled layout", "[tiled]")
+{
+    using tiled = layout_tiled<4, 2>;
+
+    SECTION("mapping")
+    {
+        auto const m = tiled::mapping<dextents<2>>{dextents<2>{6, 5}};
+        REQUIRE(m(0, 0) == 0);
+        REQUIRE(m(0, 1) == 1);
+        REQUIRE(m(1, 0) == 2);
+        REQUIRE(m(3, 1) == 7);
+        REQUIRE(m(0, 2) == 8);
+        REQUIRE(m(4, 0) == 24);
+        REQUIRE(m(5, 4) == 40 + 2);
+
+        // 2 rows of 3 tiles of 8 elements, edge tiles padded
+        REQUIRE(m.required_span_size() == 48);
+        REQUIRE(is_unique_within_span(m, 6, 5));
+    }
+
+    SECTION("owning array")
+    {
+        auto const matrix = numbered<tiled>(6, 5);
+        REQUIRE(matrix.container().size() == 48);
+        REQUIRE(matrix(5, 4) == 504);
+        REQUIRE(matrix.at(2, 3) == 203);
+        REQUIRE_THROWS_AS(matrix.at(6, 0), std::out_of_range);
+    }
+}
+
+
+TEST_CASE("morton layout", "[tiled]")
+{
+    SECTION("square mapping")
+    {
+        auto const m = layout_morton::mapping<dextents<2>>{dextents<2>{4, 4}};
+        REQUIRE(m(0, 0) == 0);
+        REQUIRE(m(0, 1) == 1);
+        REQUIRE(m(1, 0) == 2);
+        REQUIRE(m(1, 1) == 3);
+        REQUIRE(m(0, 2) == 4);
+        REQUIRE(m(2, 0) == 8);
+        REQUIRE(m(3, 3) == 15);
+        REQUIRE(m.required_span_size() == 16);
+    }
+
+    SECTION("padded and rectangular extents")
+    {
+        for (auto const& [rows, cols] : {std::pair{5, 3}, std::pair{3, 17}, std::pair{64, 4}, std::pair{1, 9}, std::pair{33, 33}})
+        {
+            auto const m = layout_morton::mapping<dextents<2>>{dextents<2>{rows, cols}};
+            REQUIRE(is_unique_within_span(m, rows, cols));
+        }
+
+        auto const wide = layout_morton::mapping<dextents<2>>{dextents<2>{2, 8}};
+        REQUIRE(wide.required_span_size() == 16);
+        REQUIRE(wide(1, 1) == 3);
+        REQUIRE(wide(0, 2) == 4);
+        REQUIRE(wide(1, 7) == 15);
+
+        REQUIRE(layout_morton::mapping<dextents<2>>{dextents<2>{0, 8}}.required_span_size() == 0);
+    }
+
+    SECTION("owning array")
+    {
+        auto const matrix = numbered<layout_morton>(7, 9);
+        REQUIRE(matrix(6, 8) == 608);
+        REQUIRE(matrix.container().size() == 8 * 16);
+    }
+}
+
+
+TEST_CASE("tiles", "[tiled]")
+{
+    SECTION("tiles of a row-major matrix")
+    {
+        auto matrix = numbered<layout_right>(5, 7);
+        auto const range = bosswestfalen::tiles<2, 4>(matrix.view());
+        REQUIRE(range.size() == 6);
+        REQUIRE(range.tiles_per_row() == 2);
+
+        auto visited = 0;
+        auto count = std::size_t{0};
+        for (auto const& [row, col, block] : range)
+        {
+            REQUIRE(row == count / 2 * 2);
+            REQUIRE(col == count % 2 * 4);
+            for (auto i = std::size_t{0}; i < block.extent(0); ++i)
+            {
+                for (auto j = std::size_t{0}; j < block.extent(1); ++j)
+                {
+                    REQUIRE(block(i, j) == matrix(row + i, col + j));
+                    ++visited;
+                }
+            }
+            ++count;
+        }
+        REQUIRE(visited == 35);
+
+        auto const edge = range(2, 1);
+        REQUIRE(edge.view.extent(0) == 1);
+        REQUIRE(edge.view.extent(1) == 3);
+        edge.view(0, 2) = -1;
+        REQUIRE(matrix(4, 6) == -1);
+    }
+
+    SECTION("tiles of a tiled matrix are contiguous")
+    {
+        auto const matrix = numbered<layout_tiled<4, 4>>(9, 6);
+        auto const range = bosswestfalen::tiles(matrix.view());
+        REQUIRE(range.size() == 6);
+
+        auto expected = matrix.data();
+        for (auto const& [row, col, block] : range)
+        {
+            REQUIRE(block.data() == expected);
+            REQUIRE(block(0, 0) == static_cast<int>(100 * row + col));
+            REQUIRE(block.stride(0) == 4);
+            expected += 16;
+        }
+
+        auto const last = range(2, 1);
+        REQUIRE(last.view.extent(0) == 1);
+        REQUIRE(last.view.extent(1) == 2);
+        REQUIRE(last.view(0, 1) == 805);
+    }
+
+    SECTION("empty matrix")
+    {
+        auto const matrix = runtime_array2d<int>{};
+        auto const range = bosswestfalen::tiles<8, 8>(matrix.view());
+        REQUIRE(range.size() == 0);
+        REQUIRE(range.begin() == range.end());
+    }
+}
+
+
+TEST_CASE("conversion between layouts", "[tiled]")
+{
+    auto const rows = std::size_t{37};
+    auto const cols = std::size_t{70};
+    auto const source = numbered<layout_right>(rows, cols);
+
+    SECTION("row-major to tiled and back")
+    {
+        auto tiled = runtime_array2d<int, layout_tiled<8, 16>>(rows, cols);
+        bosswestfalen::copy_elements(source.view(), tiled.view());
+        REQUIRE(tiled(36, 69) == 3669);
+        REQUIRE(tiled(9, 17) == 917);
+
+        auto back = runtime_array2d<int>(rows, cols);
+        bosswestfalen::copy_elements(std::as_const(tiled).view(), back.view());
+        REQUIRE(back == source);
+    }
+
+    SECTION("morton and column-major")
+    {
+        auto morton = runtime_array2d<int, layout_morton>(rows, cols);
+        bosswestfalen::copy_elements(source.view(), morton.view());
+
+        auto columns = runtime_array2d<int, layout_left>(rows, cols);
+        bosswestfalen::copy_elements(std::as_const(morton).view(), columns.view());
+        REQUIRE(columns(36, 69) == 3669);
+        REQUIRE(columns(20, 3) == 2003);
+    }
+
+    SECTION("non-trivial elements")
+    {
+        auto strings = runtime_array2d<std::string>(3, 3);
+        strings(2, 1) = "x";
+        auto tiled = runtime_array2d<std::string, layout_tiled<2, 2>>(3, 3);
+        bosswestfalen::copy_elements(std::as_const(strings).view(), tiled.view());
+        REQUIRE(tiled(2, 1) == "x");
+    }
+
+    SECTION("extents must match")
+    {
+        auto other = runtime_array2d<int>(cols, rows);
+        REQUIRE_THROWS_AS(bosswestfalen::copy_elements(source.view(), other.view()), std::invalid_argument);
+    }
+}
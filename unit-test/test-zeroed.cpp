@@ -0,0 +1,111 @@
+#include "bosswestfalen/huge_page_allocator.hpp"
+#include "bosswestfalen/page_allocator.hpp"
+#include "catch/catch.hpp"
+#include <cstdint>
+#include <cstring>
+
+
+namespace
+{
+/// allocator with allocate_zeroed(), that counts its calls
+template <typename T>
+struct zeroing_allocator
+{
+    using value_type = T;
+
+    zeroing_allocator() = default;
+
+    template <typename U>
+    zeroing_allocator(zeroing_allocator<U> const&)
+    {
+    }
+
+    T* allocate(std::size_t const n)
+    {
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    T* allocate_zeroed(std::size_t const n)
+    {
+        ++zeroed_allocations;
+        auto const p = allocate(n);
+        std::memset(p, 0, n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T* const p, std::size_t const n)
+    {
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    friend bool operator==(zeroing_allocator const&, zeroing_allocator const&)
+    {
+        return true;
+    }
+
+    friend bool operator!=(zeroing_allocator const&, zeroing_allocator const&)
+    {
+        return false;
+    }
+
+    static inline int zeroed_allocations{0};
+};
+
+/// check whether all elements are zero
+template <typename A>
+auto all_zero(A const& rta)
+{
+    return std::all_of(rta.cbegin(), rta.cend(), [](auto const v) { return v == 0; });
+}
+} // namespace
+
+
+TEST_CASE("value-initialised arrays from zeroed memory", "[zeroed]")
+{
+    SECTION("allocate_zeroed of the allocator is used")
+    {
+        auto const before = zeroing_allocator<int>::zeroed_allocations;
+        auto const rta = bosswestfalen::runtime_array<int, zeroing_allocator<int>>(100, bosswestfalen::value_initialise);
+        REQUIRE(all_zero(rta));
+        REQUIRE(zeroing_allocator<int>::zeroed_allocations == before + 1);
+
+        auto const other = bosswestfalen::runtime_array<int, zeroing_allocator<int>>(100, 1);
+        REQUIRE(zeroing_allocator<int>::zeroed_allocations == before + 1);
+    }
+
+    SECTION("page_allocator")
+    {
+        using test_array = bosswestfalen::page_runtime_array<std::uint32_t>;
+
+        SECTION("small arrays")
+        {
+            auto const rta = test_array(10, bosswestfalen::value_initialise);
+            REQUIRE_FALSE(test_array::allocator_type::uses_pages(rta.size()));
+            REQUIRE(all_zero(rta));
+        }
+
+        SECTION("large arrays")
+        {
+            auto rta = test_array(1'000'000, bosswestfalen::value_initialise);
+            REQUIRE(test_array::allocator_type::uses_pages(rta.size()));
+            REQUIRE(reinterpret_cast<std::uintptr_t>(rta.data()) % bosswestfalen::detail::page_size() == 0);
+            REQUIRE(all_zero(rta));
+
+            rta[123'456] = 1;
+            auto const copy = rta;
+            REQUIRE(copy == rta);
+        }
+
+        SECTION("other ctors")
+        {
+            auto const rta = test_array(1'000'000, 5);
+            REQUIRE(rta.back() == 5);
+        }
+    }
+
+    SECTION("huge_page_allocator")
+    {
+        auto const rta = bosswestfalen::huge_page_runtime_array<double>(bosswestfalen::huge_page_size, bosswestfalen::value_initialise);
+        REQUIRE(all_zero(rta));
+    }
+}